@@ -0,0 +1,258 @@
+/*
+ *  Created on: 15/10/2026
+ *      Author: ricab
+ *
+ * See docs/interface.md for documentation of this header's public interface.
+ */
+
+#ifndef ANY_SCOPE_GUARD_HPP_
+#define ANY_SCOPE_GUARD_HPP_
+
+#include "scope_guard.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sg
+{
+  namespace detail
+  {
+    /* --- Type erasure for callbacks kept in raw buffers --- */
+
+    // Holds a callback of (possibly reference) type Callback
+    template<typename Callback>
+    struct callback_holder
+    {
+      explicit callback_holder(Callback&& callback)
+      noexcept(detail::is_nothrow_self_constructible_t<Callback>::value);
+
+      Callback m_callback;
+    };
+
+    // The operations on a type-erased callback holder (a single vtable)
+    struct erased_callback_ops
+    {
+      void (*invoke)(void* holder); // never throws (precondition)
+      void (*relocate)(void* from, void* to); /* moves to uninitialized memory
+      and destroys the source; null when a plain copy of the bytes suffices */
+      void (*destroy)(void* holder); // null when trivially destructible
+    };
+
+    // The operations for a specific holder type
+    template<typename Holder>
+    struct erased_callback
+    {
+      static void invoke(void* holder) noexcept;
+      static void relocate(void* from, void* to) noexcept;
+      static void destroy(void* holder) noexcept;
+
+      static const erased_callback_ops ops;
+    };
+
+    // Type trait determining whether a callback can be held in a buffer
+    template<typename Callback, std::size_t BufferSize>
+    struct fits_buffer_t
+      : public std::integral_constant<
+          bool,
+          sizeof(callback_holder<Callback>) <= BufferSize &&
+          alignof(callback_holder<Callback>) <= alignof(std::max_align_t)>
+    {};
+
+  } // namespace detail
+
+
+  /* --- A type-erased scope guard, with an inline buffer --- */
+
+  template<std::size_t BufferSize = 3 * sizeof(void*)>
+  class any_scope_guard;
+
+  template<std::size_t BufferSize = 3 * sizeof(void*), typename Callback>
+  auto make_any_scope_guard(Callback&& callback)
+  noexcept(detail::is_nothrow_self_constructible_t<Callback>::value)
+  -> typename std::enable_if<detail::is_proper_sg_callback_t<Callback>::value,
+                             any_scope_guard<BufferSize>>::type;
+
+  template<std::size_t BufferSize>
+  class any_scope_guard final
+  {
+  public:
+    any_scope_guard(any_scope_guard&& other) noexcept;
+    any_scope_guard& operator=(any_scope_guard&& other) noexcept; /* calls back
+    first, if active (as if destroyed and move-constructed) */
+
+    ~any_scope_guard() noexcept; // highlight noexcept dtor
+
+    void dismiss() noexcept; // also destroys the callback
+
+  public:
+    any_scope_guard() = delete;
+    any_scope_guard(const any_scope_guard&) = delete;
+    any_scope_guard& operator=(const any_scope_guard&) = delete;
+
+  private:
+    template<typename Callback>
+    explicit any_scope_guard(Callback&& callback)
+    noexcept(detail::is_nothrow_self_constructible_t<Callback>::value); /*
+                                                      meant for friends only */
+
+    template<std::size_t B, typename Callback>
+    friend auto make_any_scope_guard(Callback&& callback)
+    noexcept(detail::is_nothrow_self_constructible_t<Callback>::value)
+    -> typename std::enable_if<detail::is_proper_sg_callback_t<Callback>::value,
+                               any_scope_guard<B>>::type;
+
+    void release() noexcept; // calls back if active, then destroys
+    void take(any_scope_guard& other) noexcept; // from a released guard
+
+  private:
+    alignas(std::max_align_t) unsigned char m_buffer[BufferSize];
+    const detail::erased_callback_ops* m_ops; // null when inactive
+
+  };
+
+} // namespace sg
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Callback>
+sg::detail::callback_holder<Callback>::callback_holder(Callback&& callback)
+noexcept(detail::is_nothrow_self_constructible_t<Callback>::value)
+  : m_callback(std::forward<Callback>(callback)) // () for DR 1467
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Holder>
+void sg::detail::erased_callback<Holder>::invoke(void* holder) noexcept
+{
+  static_cast<Holder*>(holder)->m_callback();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Holder>
+void sg::detail::erased_callback<Holder>::relocate(void* from, void* to)
+noexcept
+{
+  auto& source = *static_cast<Holder*>(from);
+  ::new(to) Holder(std::move(source));
+  source.~Holder();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Holder>
+void sg::detail::erased_callback<Holder>::destroy(void* holder) noexcept
+{
+  static_cast<Holder*>(holder)->~Holder();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Holder>
+const sg::detail::erased_callback_ops
+sg::detail::erased_callback<Holder>::ops = {
+  &erased_callback<Holder>::invoke,
+  std::is_trivially_copyable<Holder>::value
+    ? nullptr
+    : &erased_callback<Holder>::relocate,
+  std::is_trivially_destructible<Holder>::value
+    ? nullptr
+    : &erased_callback<Holder>::destroy
+};
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t BufferSize>
+template<typename Callback>
+sg::any_scope_guard<BufferSize>::any_scope_guard(Callback&& callback)
+noexcept(detail::is_nothrow_self_constructible_t<Callback>::value)
+  : m_ops{nullptr}
+{
+  typedef detail::callback_holder<Callback> holder;
+  static_assert(detail::fits_buffer_t<Callback, BufferSize>::value,
+                "callback too large (or over-aligned) for any_scope_guard's "
+                "BufferSize");
+  static_assert(std::is_nothrow_move_constructible<holder>::value,
+                "any_scope_guard needs callbacks that are nothrow movable "
+                "(consider passing an lvalue instead)");
+
+  ::new(static_cast<void*>(m_buffer)) holder(std::forward<Callback>(callback));
+  m_ops = &detail::erased_callback<holder>::ops;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t BufferSize>
+sg::any_scope_guard<BufferSize>::any_scope_guard(any_scope_guard&& other)
+noexcept
+  : m_ops{nullptr}
+{
+  take(other);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t BufferSize>
+auto sg::any_scope_guard<BufferSize>::operator=(any_scope_guard&& other)
+noexcept -> any_scope_guard&
+{
+  if(this != &other)
+  {
+    release();
+    take(other);
+  }
+
+  return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t BufferSize>
+sg::any_scope_guard<BufferSize>::~any_scope_guard() noexcept
+{
+  release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t BufferSize>
+inline void sg::any_scope_guard<BufferSize>::dismiss() noexcept
+{
+  if(m_ops && m_ops->destroy)
+    m_ops->destroy(m_buffer);
+  m_ops = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t BufferSize>
+inline void sg::any_scope_guard<BufferSize>::release() noexcept
+{
+  if(m_ops)
+  {
+    m_ops->invoke(m_buffer);
+    dismiss();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t BufferSize>
+inline void sg::any_scope_guard<BufferSize>::take(any_scope_guard& other)
+noexcept
+{
+  if(other.m_ops)
+  {
+    if(other.m_ops->relocate)
+      other.m_ops->relocate(other.m_buffer, m_buffer);
+    else
+      std::memcpy(m_buffer, other.m_buffer, BufferSize);
+
+    m_ops = other.m_ops;
+    other.m_ops = nullptr;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t BufferSize, typename Callback>
+inline auto sg::make_any_scope_guard(Callback&& callback)
+noexcept(detail::is_nothrow_self_constructible_t<Callback>::value)
+-> typename std::enable_if<detail::is_proper_sg_callback_t<Callback>::value,
+                           any_scope_guard<BufferSize>>::type
+{
+  return any_scope_guard<BufferSize>{std::forward<Callback>(callback)};
+}
+
+#endif /* ANY_SCOPE_GUARD_HPP_ */
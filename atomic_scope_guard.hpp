@@ -0,0 +1,133 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * See docs/interface.md for documentation of this header's public interface.
+ */
+
+#ifndef ATOMIC_SCOPE_GUARD_HPP_
+#define ATOMIC_SCOPE_GUARD_HPP_
+
+#include "scope_guard.hpp"
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+namespace sg
+{
+  namespace detail
+  {
+    /* --- A scope guard with an atomic flag, for cross-thread dismissal --- */
+
+#ifdef SG_HAS_CONCEPTS
+    template<scope_guard_callback Callback, typename = void>
+#else
+    template<typename Callback,
+             typename = typename std::enable_if<
+               is_proper_sg_callback_t<Callback>::value>::type>
+#endif
+    class atomic_scope_guard;
+
+    template<SG_CALLBACK_TYPENAME Callback>
+    atomic_scope_guard<Callback> make_atomic_scope_guard(Callback&& callback)
+    noexcept(is_nothrow_self_constructible_t<Callback>::value); /*
+    in the inner namespace for the same reason as make_scope_guard */
+
+    template<SG_CALLBACK_TYPENAME Callback>
+    class atomic_scope_guard<Callback> final
+      : private callback_storage<Callback>
+    {
+    public:
+      typedef Callback callback_type;
+
+      atomic_scope_guard(atomic_scope_guard&& other)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value); /* not to be
+      used while other threads may dismiss other */
+
+      ~atomic_scope_guard() noexcept; /* calls back unless dismissed (exchange,
+      so that exactly one of it and a racing try_dismiss wins) */
+
+      void dismiss() noexcept; // from any thread (release)
+      bool try_dismiss() noexcept; /* idem (acquire and release), but tells
+      whether this call is the one that dismissed the guard */
+
+    public:
+      atomic_scope_guard() = delete;
+      atomic_scope_guard(const atomic_scope_guard&) = delete;
+      atomic_scope_guard& operator=(const atomic_scope_guard&) = delete;
+      atomic_scope_guard& operator=(atomic_scope_guard&&) = delete;
+
+    private:
+      explicit atomic_scope_guard(Callback&& callback)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value); /*
+                                                      meant for friends only */
+
+      friend atomic_scope_guard<Callback>
+      make_atomic_scope_guard<Callback>(Callback&&)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value);
+
+    private:
+      std::atomic<bool> m_active;
+
+    };
+
+  } // namespace detail
+
+
+  /* --- Now the public maker function --- */
+
+  using detail::make_atomic_scope_guard; // see comment on declaration above
+
+} // namespace sg
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+sg::detail::atomic_scope_guard<Callback>::atomic_scope_guard(
+  Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+  : callback_storage<Callback>(std::forward<Callback>(callback))
+  , m_active{true}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+sg::detail::atomic_scope_guard<Callback>::atomic_scope_guard(
+  atomic_scope_guard&& other)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+  : callback_storage<Callback>(std::forward<Callback>(other.callback()))
+  , m_active{other.m_active.exchange(false, std::memory_order_acq_rel)}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+sg::detail::atomic_scope_guard<Callback>::~atomic_scope_guard() noexcept
+{
+  if(m_active.exchange(false, std::memory_order_acq_rel))
+    this->callback()();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+inline void sg::detail::atomic_scope_guard<Callback>::dismiss() noexcept
+{
+  m_active.store(false, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+inline bool sg::detail::atomic_scope_guard<Callback>::try_dismiss() noexcept
+{
+  return m_active.exchange(false, std::memory_order_acq_rel);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+inline auto sg::detail::make_atomic_scope_guard(Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+-> atomic_scope_guard<Callback>
+{
+  return atomic_scope_guard<Callback>{std::forward<Callback>(callback)};
+}
+
+#endif /* ATOMIC_SCOPE_GUARD_HPP_ */
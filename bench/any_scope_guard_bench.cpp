@@ -0,0 +1,95 @@
+/*
+ *  Created on: 15/10/2026
+ *      Author: ricab
+ *
+ * Benchmarks any_scope_guard against scope_guard<std::function<void()>>.
+ */
+
+#include "any_scope_guard.hpp"
+#include "bench.hpp"
+#include "scope_guard.hpp"
+
+#include <functional>
+#include <utility>
+
+using namespace sg;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  auto small_rollback(unsigned& sink) noexcept // 8 byte capture
+  {
+    return [&sink]() noexcept { ++sink; };
+  }
+
+  auto large_rollback(unsigned& sink, unsigned a, unsigned b, unsigned c,
+                      unsigned d) noexcept // 24 byte capture
+  {
+    return [&sink, a, b, c, d]() noexcept { sink += a + b + c + d; };
+  }
+
+  template<typename MakeGuard>
+  void construct_destroy(std::size_t iterations, MakeGuard make_guard)
+  {
+    auto sink = 0u;
+    for(std::size_t it = 0; it < iterations; ++it)
+    {
+      auto guard = make_guard(sink, static_cast<unsigned>(it));
+      bench::do_not_optimize(guard);
+    }
+    bench::do_not_optimize(sink);
+  }
+
+  template<typename MakeGuard>
+  void construct_move_destroy(std::size_t iterations, MakeGuard make_guard)
+  {
+    auto sink = 0u;
+    for(std::size_t it = 0; it < iterations; ++it)
+    {
+      auto guard = make_guard(sink, static_cast<unsigned>(it));
+      auto moved = std::move(guard);
+      bench::do_not_optimize(moved);
+    }
+    bench::do_not_optimize(sink);
+  }
+
+  auto any_small = [](unsigned& sink, unsigned) {
+    return make_any_scope_guard(small_rollback(sink));
+  };
+  auto any_large = [](unsigned& sink, unsigned i) {
+    return make_any_scope_guard(large_rollback(sink, i, i, i, i));
+  };
+  auto function_small = [](unsigned& sink, unsigned) {
+    return make_scope_guard(std::function<void()>{small_rollback(sink)});
+  };
+  auto function_large = [](unsigned& sink, unsigned i) {
+    return make_scope_guard(
+      std::function<void()>{large_rollback(sink, i, i, i, i)});
+  };
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("any_scope_guard/capture_8/construct+destroy")
+{
+  construct_destroy(iterations, any_small);
+}
+SG_BENCHMARK("any_scope_guard/capture_24/construct+destroy")
+{
+  construct_destroy(iterations, any_large);
+}
+SG_BENCHMARK("any_scope_guard/capture_24/construct+move+destroy")
+{
+  construct_move_destroy(iterations, any_large);
+}
+SG_BENCHMARK("scope_guard<function>/capture_8/construct+destroy")
+{
+  construct_destroy(iterations, function_small);
+}
+SG_BENCHMARK("scope_guard<function>/capture_24/construct+destroy")
+{
+  construct_destroy(iterations, function_large);
+}
+SG_BENCHMARK("scope_guard<function>/capture_24/construct+move+destroy")
+{
+  construct_move_destroy(iterations, function_large);
+}
@@ -0,0 +1,99 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * Benchmarks the single-threaded cost of the atomic flag in atomic_scope_guard,
+ * against the plain bool in scope_guard: construction (followed by destruction,
+ * which executes the callback), dismissal and try_dismiss. This measures the
+ * atomic operations themselves, not contention between threads.
+ */
+
+#include "atomic_scope_guard.hpp"
+#include "bench.hpp"
+#include "scope_guard.hpp"
+
+#include <utility>
+
+using namespace sg;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  unsigned ticks = 0u;
+
+  struct plain_maker
+  {
+    template<typename Callback>
+    auto operator()(Callback&& callback) const noexcept
+    {
+      return make_scope_guard(std::forward<Callback>(callback));
+    }
+  };
+
+  struct atomic_maker
+  {
+    template<typename Callback>
+    auto operator()(Callback&& callback) const noexcept
+    {
+      return make_atomic_scope_guard(std::forward<Callback>(callback));
+    }
+  };
+
+  template<typename Maker>
+  void construct_destroy(std::size_t iterations, Maker make)
+  {
+    for(std::size_t it = 0; it < iterations; ++it)
+    {
+      auto guard = make([]() noexcept { ++ticks; });
+      bench::do_not_optimize(guard);
+    }
+    bench::do_not_optimize(ticks);
+  }
+
+  template<typename Maker>
+  void dismiss(std::size_t iterations, Maker make)
+  {
+    for(std::size_t it = 0; it < iterations; ++it)
+    {
+      auto guard = make([]() noexcept { ++ticks; });
+      bench::do_not_optimize(guard);
+      guard.dismiss();
+    }
+    bench::do_not_optimize(ticks);
+  }
+
+  void try_dismiss(std::size_t iterations)
+  {
+    auto wins = 0u;
+    for(std::size_t it = 0; it < iterations; ++it)
+    {
+      auto guard = make_atomic_scope_guard([]() noexcept { ++ticks; });
+      bench::do_not_optimize(guard);
+      wins += guard.try_dismiss();
+    }
+    bench::do_not_optimize(wins);
+    bench::do_not_optimize(ticks);
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("scope_guard/flag/construct")
+{
+  construct_destroy(iterations, plain_maker{});
+}
+SG_BENCHMARK("atomic_scope_guard/flag/construct")
+{
+  construct_destroy(iterations, atomic_maker{});
+}
+SG_BENCHMARK("scope_guard/flag/dismiss")
+{
+  dismiss(iterations, plain_maker{});
+}
+SG_BENCHMARK("atomic_scope_guard/flag/dismiss")
+{
+  dismiss(iterations, atomic_maker{});
+}
+SG_BENCHMARK("atomic_scope_guard/flag/try_dismiss")
+{
+  try_dismiss(iterations);
+}
@@ -0,0 +1,70 @@
+/*
+ *  Created on: 15/10/2026
+ *      Author: ricab
+ *
+ * A minimal microbenchmark harness, without dependencies. Benchmarks are
+ * registered with SG_BENCHMARK and run by bench_main.cpp.
+ */
+
+#ifndef SG_BENCH_HPP_
+#define SG_BENCH_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace bench
+{
+  // A benchmark runs its operation the specified number of times
+  typedef void (*benchmark_fun)(std::size_t iterations);
+
+  struct benchmark
+  {
+    const char* name;
+    benchmark_fun run;
+  };
+
+  std::vector<benchmark>& registry(); // defined in bench_main.cpp
+
+  struct registrar
+  {
+    registrar(const char* name, benchmark_fun run)
+    {
+      registry().push_back(benchmark{name, run});
+    }
+  };
+
+  // prevent the compiler from optimizing away the computation of value
+  template<typename T>
+  inline void do_not_optimize(T& value) noexcept
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : "+r,m"(value) : : "memory");
+#else
+    auto volatile sink = &value;
+    (void)sink;
+#endif
+  }
+} // namespace bench
+
+// prevent the compiler from inlining a function (e.g. to keep stack frames)
+#if defined(__GNUC__) || defined(__clang__)
+#define SG_BENCH_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define SG_BENCH_NOINLINE __declspec(noinline)
+#else
+#define SG_BENCH_NOINLINE
+#endif
+
+#define SG_BENCH_CONCAT_IMPL(a, b) a##b
+#define SG_BENCH_CONCAT(a, b) SG_BENCH_CONCAT_IMPL(a, b)
+
+/* Defines and registers a benchmark with the given name. The body that follows
+is the benchmark function, which receives the parameter `iterations`. */
+#define SG_BENCHMARK(name)                                                     \
+  static void SG_BENCH_CONCAT(sg_bench_fun_, __LINE__)(std::size_t);           \
+  static const bench::registrar SG_BENCH_CONCAT(sg_bench_reg_, __LINE__){      \
+    name, &SG_BENCH_CONCAT(sg_bench_fun_, __LINE__)};                          \
+  static void SG_BENCH_CONCAT(sg_bench_fun_, __LINE__)(                        \
+    std::size_t iterations)
+
+#endif /* SG_BENCH_HPP_ */
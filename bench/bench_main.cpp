@@ -0,0 +1,251 @@
+/*
+ *  Created on: 15/10/2026
+ *      Author: ricab
+ *
+ * Runs the registered benchmarks and prints the time, the number of
+ * instructions per operation and the instructions per cycle of each.
+ * Usage: scope_guard_bench [--json] [filter]
+ * Only benchmarks whose name contains filter are run. With --json, results are
+ * printed as a JSON document instead of a table. Instructions and cycles are
+ * counted with perf_event_open, on Linux, when permitted; otherwise they are
+ * null (or n/a).
+ */
+
+#include "bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<bench::benchmark>& bench::registry()
+{
+  static std::vector<benchmark> benchmarks;
+  return benchmarks;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  using steady = std::chrono::steady_clock;
+
+  constexpr auto min_duration = std::chrono::milliseconds{20};
+  constexpr auto repetitions = 5;
+
+#ifdef __linux__
+  constexpr std::uint64_t instructions_event = PERF_COUNT_HW_INSTRUCTIONS;
+  constexpr std::uint64_t cycles_event = PERF_COUNT_HW_CPU_CYCLES;
+#else
+  constexpr std::uint64_t instructions_event = 0; // not counted
+  constexpr std::uint64_t cycles_event = 0; // idem
+#endif
+
+  /* Counts a user-space hardware event in this thread (e.g. instructions
+  retired), where possible */
+  class perf_counter
+  {
+  public:
+    explicit perf_counter(std::uint64_t event) noexcept
+    {
+#ifdef __linux__
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = event;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      m_fd = static_cast<int>(
+        syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0)); // this thread
+#else
+      (void)event;
+#endif
+    }
+
+    ~perf_counter()
+    {
+#ifdef __linux__
+      if(available())
+        close(m_fd);
+#endif
+    }
+
+    perf_counter(const perf_counter&) = delete;
+    perf_counter& operator=(const perf_counter&) = delete;
+
+    bool available() const noexcept { return m_fd >= 0; }
+
+    void start() noexcept
+    {
+#ifdef __linux__
+      ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    std::uint64_t stop() noexcept
+    {
+      std::uint64_t count = 0;
+#ifdef __linux__
+      ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+      if(read(m_fd, &count, sizeof(count)) != sizeof(count))
+        count = 0;
+#endif
+      return count;
+    }
+
+  private:
+    int m_fd = -1;
+  };
+
+  struct result
+  {
+    double ns_per_op;
+    double instructions_per_op; // negative when not available
+    double cycles_per_op; // idem
+    std::size_t iterations;
+  };
+
+  double measure_ns(const bench::benchmark& b, std::size_t iterations)
+  {
+    const auto start = steady::now();
+    b.run(iterations);
+    const auto end = steady::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+  }
+
+  // the best count of counter's event per operation, negative if unavailable
+  double count_per_op(const bench::benchmark& b, std::size_t iterations,
+                      perf_counter& counter)
+  {
+    if(!counter.available())
+      return -1.0;
+
+    auto best = 0.0;
+    for(auto i = 0; i < repetitions; ++i)
+    {
+      counter.start();
+      b.run(iterations);
+      const auto count = static_cast<double>(counter.stop());
+      best = i ? std::min(best, count) : count;
+    }
+
+    return best / static_cast<double>(iterations);
+  }
+
+  // the best per-operation figures, once iterations take long enough
+  result measure(const bench::benchmark& b, perf_counter& instructions,
+                 perf_counter& cycles)
+  {
+    std::size_t iterations = 1;
+    while(measure_ns(b, iterations) <
+          std::chrono::duration<double, std::nano>(min_duration).count())
+      iterations *= 2;
+
+    auto best = measure_ns(b, iterations);
+    for(auto i = 1; i < repetitions; ++i)
+      best = std::min(best, measure_ns(b, iterations));
+
+    return result{best / static_cast<double>(iterations),
+                  count_per_op(b, iterations, instructions),
+                  count_per_op(b, iterations, cycles),
+                  iterations};
+  }
+
+  void print_json_string(const char* str)
+  {
+    std::putchar('"');
+    for(; *str; ++str)
+      if(*str == '"' || *str == '\\')
+        std::printf("\\%c", *str);
+      else if(static_cast<unsigned char>(*str) < 0x20)
+        std::printf("\\u%04x", static_cast<unsigned>(*str));
+      else
+        std::putchar(*str);
+    std::putchar('"');
+  }
+
+  // instructions per cycle, negative when not available
+  double ipc(const result& r)
+  {
+    return r.instructions_per_op < 0 || r.cycles_per_op <= 0
+      ? -1.0 : r.instructions_per_op / r.cycles_per_op;
+  }
+
+  void print_json_number(const char* name, double value)
+  {
+    std::printf(", \"%s\": ", name);
+    if(value < 0)
+      std::printf("null");
+    else
+      std::printf("%.3f", value);
+  }
+
+  void print_json(const bench::benchmark& b, const result& r, bool first)
+  {
+    std::printf("%s\n    {\"name\": ", first ? "" : ",");
+    print_json_string(b.name);
+    std::printf(", \"ns_per_op\": %.3f", r.ns_per_op);
+    print_json_number("instructions_per_op", r.instructions_per_op);
+    print_json_number("cycles_per_op", r.cycles_per_op);
+    std::printf(", \"iterations\": %zu}", r.iterations);
+  }
+
+  void print_row(const bench::benchmark& b, const result& r)
+  {
+    std::printf("%-56s %10.2f ns/op", b.name, r.ns_per_op);
+    if(r.instructions_per_op < 0)
+      std::printf(" %10s instr/op", "n/a");
+    else
+      std::printf(" %10.1f instr/op", r.instructions_per_op);
+    if(ipc(r) < 0)
+      std::printf(" %6s IPC\n", "n/a");
+    else
+      std::printf(" %6.2f IPC\n", ipc(r));
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+  auto json = false;
+  const char* filter = "";
+  for(auto i = 1; i < argc; ++i)
+    if(!std::strcmp(argv[i], "--json"))
+      json = true;
+    else
+      filter = argv[i];
+
+  perf_counter instructions{instructions_event};
+  perf_counter cycles{cycles_event};
+  auto first = true;
+
+  if(json)
+    std::printf("{\n  \"benchmarks\": [");
+
+  for(const auto& b : bench::registry())
+    if(std::strstr(b.name, filter))
+    {
+      const auto r = measure(b, instructions, cycles);
+      if(json)
+        print_json(b, r, first);
+      else
+        print_row(b, r);
+      first = false;
+    }
+
+  if(json)
+    std::printf("\n  ]\n}\n");
+
+  return 0;
+}
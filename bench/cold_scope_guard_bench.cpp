@@ -0,0 +1,94 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * Benchmarks a tight loop over many distinct steps, each guarded by a rollback
+ * that is never executed (the steps succeed and dismiss their guards). With a
+ * scope_guard, each rollback body is inlined into its step, between the hot
+ * instructions. With a cold_scope_guard, it is kept out of line, in a cold
+ * section. There are enough steps for the difference to matter to the
+ * instruction cache, which shows in the time and, where counters are
+ * available, in the instructions per cycle.
+ */
+
+#include "bench.hpp"
+#include "cold_scope_guard.hpp"
+#include "scope_guard.hpp"
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+using namespace sg;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  constexpr std::size_t step_count = 512; // ~64 bytes of rollback each
+  std::array<unsigned, 16> state;
+  volatile bool steps_succeed = true; // always, but opaque to the compiler
+
+  // a rollback that is long enough to matter, and distinct per step
+  template<std::size_t N>
+  void rollback(volatile unsigned* s) noexcept
+  {
+    s[0] = N; s[1] = N ^ 1u; s[2] = N ^ 2u; s[3] = N ^ 3u;
+    s[4] = N ^ 4u; s[5] = N ^ 5u; s[6] = N ^ 6u; s[7] = N ^ 7u;
+  }
+
+  template<std::size_t N>
+  SG_BENCH_NOINLINE void inlined_step(unsigned* s, bool ok) noexcept
+  {
+    auto guard = make_scope_guard([s]() noexcept { rollback<N>(s); });
+    s[N % state.size()] += N; // the work, which succeeds...
+    if(ok) // ...but the compiler cannot tell
+      guard.dismiss();
+  }
+
+  template<std::size_t N>
+  SG_BENCH_NOINLINE void cold_step(unsigned* s, bool ok) noexcept
+  {
+    auto guard = make_cold_scope_guard([s]() noexcept { rollback<N>(s); });
+    s[N % state.size()] += N; // the work, which succeeds...
+    if(ok) // ...but the compiler cannot tell
+      guard.dismiss();
+  }
+
+  using step_fun = void (*)(unsigned*, bool) noexcept;
+  using step_table = std::array<step_fun, step_count>;
+
+  template<std::size_t... Ns>
+  constexpr step_table inlined_steps(std::index_sequence<Ns...>)
+  {
+    return {{&inlined_step<Ns>...}};
+  }
+
+  template<std::size_t... Ns>
+  constexpr step_table cold_steps(std::index_sequence<Ns...>)
+  {
+    return {{&cold_step<Ns>...}};
+  }
+
+  // runs every step, in order, per iteration
+  void run_steps(std::size_t iterations, const step_table& steps)
+  {
+    const bool ok = steps_succeed;
+    for(std::size_t it = 0; it < iterations; ++it)
+      for(const auto step : steps)
+        step(state.data(), ok);
+    bench::do_not_optimize(state);
+  }
+
+  const auto inlined = inlined_steps(std::make_index_sequence<step_count>{});
+  const auto cold = cold_steps(std::make_index_sequence<step_count>{});
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("scope_guard/rollback_512_steps/inlined")
+{
+  run_steps(iterations, inlined);
+}
+SG_BENCHMARK("cold_scope_guard/rollback_512_steps/cold")
+{
+  run_steps(iterations, cold);
+}
@@ -0,0 +1,68 @@
+/*
+ *  Created on: 15/10/2026
+ *      Author: ricab
+ *
+ * Benchmarks committing a batch of guards with a shared commit_token against
+ * dismissing each scope_guard.
+ */
+
+#include "bench.hpp"
+#include "scope_guard.hpp"
+
+#include <vector>
+
+using namespace sg;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  constexpr auto rows = 256u;
+
+  auto undo_row(unsigned& sink, unsigned row) noexcept
+  {
+    return [&sink, row]() noexcept { sink -= row; };
+  }
+
+  using row_guard = decltype(make_scope_guard(undo_row(
+    std::declval<unsigned&>(), 0u)));
+  using token_row_guard = decltype(make_token_guard(
+    std::declval<commit_token&>(), undo_row(std::declval<unsigned&>(), 0u)));
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("scope_guard/256_rows/dismiss_each")
+{
+  auto sink = 0u;
+  std::vector<row_guard> guards;
+  guards.reserve(rows);
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    for(auto row = 0u; row < rows; ++row)
+    {
+      guards.push_back(make_scope_guard(undo_row(sink, row)));
+      sink += row;
+    }
+    for(auto& guard : guards)
+      guard.dismiss();
+    guards.clear();
+  }
+  bench::do_not_optimize(sink);
+}
+SG_BENCHMARK("token_scope_guard/256_rows/commit_token")
+{
+  auto sink = 0u;
+  std::vector<token_row_guard> guards;
+  guards.reserve(rows);
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    commit_token token;
+    for(auto row = 0u; row < rows; ++row)
+    {
+      guards.push_back(make_token_guard(token, undo_row(sink, row)));
+      sink += row;
+    }
+    token.commit();
+    guards.clear();
+  }
+  bench::do_not_optimize(sink);
+}
@@ -0,0 +1,167 @@
+/*
+ *  Created on: 15/10/2026
+ *      Author: ricab
+ *
+ * Measures the compile time and the peak memory (RSS) of the compiler when it
+ * compiles a generated translation unit with many distinct guards, against a
+ * baseline translation unit that does the same without guards.
+ * Usage: scope_guard_compile_bench [--json] [--guards N] compiler [flags...]
+ * By default, N is 10000 and the flags are -std=c++17 -fsyntax-only. This
+ * needs POSIX (fork, exec and wait4).
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  using steady = std::chrono::steady_clock;
+
+  constexpr auto repetitions = 3;
+
+  struct result
+  {
+    double seconds;
+    long peak_rss_kib;
+  };
+
+  // writes a TU with a function per guard, each guard with a distinct lambda
+  std::string generate(unsigned guards, bool guarded)
+  {
+    const auto path = std::string{guarded ? "sg_compile_bench_guarded.cpp"
+                                          : "sg_compile_bench_baseline.cpp"};
+    std::ofstream out{path};
+    out << "#include \"scope_guard.hpp\"\n"
+        << "void sg_stress_work(int);\n";
+    for(auto i = 0u; i < guards; ++i)
+    {
+      out << "void sg_stress_" << i << "(int* p)\n{\n";
+      if(guarded)
+        out << "  const auto guard = sg::make_scope_guard("
+            << "[p]() noexcept { *p = " << i << "; });\n"
+            << "  sg_stress_work(" << i << ");\n";
+      else
+        out << "  const auto undo = [p]() noexcept { *p = " << i << "; };\n"
+            << "  sg_stress_work(" << i << ");\n  undo();\n";
+      out << "}\n";
+    }
+
+    return path;
+  }
+
+  // runs the command and measures it, or exits on failure
+  result run(std::vector<std::string> command)
+  {
+    std::vector<char*> argv;
+    for(auto& arg : command)
+      argv.push_back(&arg[0]);
+    argv.push_back(nullptr);
+
+    const auto start = steady::now();
+    const auto pid = fork();
+    if(pid == 0)
+    {
+      execvp(argv[0], argv.data());
+      std::perror("exec");
+      std::_Exit(127);
+    }
+
+    int status = 0;
+    rusage usage;
+    if(pid < 0 || wait4(pid, &status, 0, &usage) != pid ||
+       !WIFEXITED(status) || WEXITSTATUS(status))
+    {
+      std::fprintf(stderr, "compilation failed: %s ...\n", argv[0]);
+      std::exit(EXIT_FAILURE);
+    }
+
+    const auto end = steady::now();
+    return result{std::chrono::duration<double>(end - start).count(),
+                  usage.ru_maxrss}; // KiB, in Linux
+  }
+
+  // the best of several runs
+  result measure(std::vector<std::string> command)
+  {
+    auto best = run(command);
+    for(auto i = 1; i < repetitions; ++i)
+    {
+      const auto r = run(command);
+      best.seconds = std::min(best.seconds, r.seconds);
+      best.peak_rss_kib = std::min(best.peak_rss_kib, r.peak_rss_kib);
+    }
+
+    return best;
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+  auto json = false;
+  auto guards = 10000u;
+  std::vector<std::string> command;
+
+  for(auto i = 1; i < argc; ++i)
+    if(command.empty() && !std::strcmp(argv[i], "--json"))
+      json = true;
+    else if(command.empty() && !std::strcmp(argv[i], "--guards") &&
+            i + 1 < argc)
+      guards = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    else
+      command.push_back(argv[i]);
+
+  if(command.empty())
+  {
+    std::fprintf(stderr, "usage: %s [--json] [--guards N] compiler [flags...]"
+                         "\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if(command.size() == 1)
+  {
+    command.push_back("-std=c++17");
+    command.push_back("-fsyntax-only");
+  }
+  command.push_back("-I" SG_SOURCE_DIR);
+
+  auto baseline_command = command;
+  baseline_command.push_back(generate(guards, false));
+  command.push_back(generate(guards, true));
+
+  const auto baseline = measure(baseline_command);
+  const auto guarded = measure(command);
+
+  if(json)
+  {
+    std::printf("{\n  \"guards\": %u,\n", guards);
+    std::printf("  \"baseline\": {\"seconds\": %.3f, \"peak_rss_kib\": %ld},\n",
+                baseline.seconds, baseline.peak_rss_kib);
+    std::printf("  \"guarded\": {\"seconds\": %.3f, \"peak_rss_kib\": %ld}"
+                "\n}\n", guarded.seconds, guarded.peak_rss_kib);
+  }
+  else
+  {
+    std::printf("%-32s %10.3f s %10ld KiB\n", "baseline", baseline.seconds,
+                baseline.peak_rss_kib);
+    std::printf("%-32s %10.3f s %10ld KiB\n", "guarded", guarded.seconds,
+                guarded.peak_rss_kib);
+    std::printf("%-32s %10.1f us %9.1f KiB\n", "added per guard",
+                (guarded.seconds - baseline.seconds) * 1e6 / guards,
+                static_cast<double>(guarded.peak_rss_kib -
+                                    baseline.peak_rss_kib) / guards);
+  }
+
+  return 0;
+}
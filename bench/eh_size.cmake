@@ -0,0 +1,94 @@
+# Measures the size of unwind tables (.eh_frame and .gcc_except_table) added
+# per guard instantiation. It generates translation units with COUNT functions
+# that each do the same step and rollback, in three variants:
+#   plain     - rollback done inline, without exception safety (the baseline)
+#   guard     - rollback in a scope_guard with a distinct lambda
+#   try_catch - rollback in a catch(...) that rethrows
+# It then compiles them to object files, with -O2, and reports the size of each
+# section, beyond the baseline, per function.
+#
+# Meant to be run in script mode (cmake -P), with the following definitions:
+#   COMPILER - the C++ compiler
+#   OBJDUMP  - the objdump tool, to read section sizes
+#   INCLUDE  - the directory with scope_guard.hpp
+#   WORK_DIR - where to write sources and objects
+#   COUNT    - (optional) the number of functions per variant, 64 by default
+
+if(NOT DEFINED COUNT)
+  set(COUNT 64)
+endif()
+
+set(sections .eh_frame .gcc_except_table)
+set(variants plain guard try_catch)
+
+# generate the sources
+foreach(variant IN LISTS variants)
+  set(src "#include \"scope_guard.hpp\"\n")
+  string(APPEND src "void sg_eh_work(int);\n") # opaque, may throw
+  math(EXPR last "${COUNT} - 1")
+  foreach(i RANGE ${last})
+    string(APPEND src "void sg_eh_f${i}(int* p)\n{\n")
+    if(variant STREQUAL "plain")
+      string(APPEND src "  sg_eh_work(${i});\n  *p = ${i};\n")
+    elseif(variant STREQUAL "guard")
+      string(APPEND src "  const auto guard = sg::make_scope_guard("
+                        "[p]() noexcept { *p = ${i}; });\n"
+                        "  sg_eh_work(${i});\n")
+    else()
+      string(APPEND src "  try\n  {\n    sg_eh_work(${i});\n  }\n"
+                        "  catch(...)\n  {\n    *p = ${i};\n    throw;\n  }\n"
+                        "  *p = ${i};\n")
+    endif()
+    string(APPEND src "}\n")
+  endforeach()
+  file(WRITE ${WORK_DIR}/eh_size_${variant}.cpp "${src}")
+endforeach()
+
+# compile and read section sizes
+foreach(variant IN LISTS variants)
+  set(obj ${WORK_DIR}/eh_size_${variant}.o)
+  execute_process(COMMAND ${COMPILER} -std=c++11 -O2 -c -I${INCLUDE}
+                          -o ${obj} ${WORK_DIR}/eh_size_${variant}.cpp
+                  RESULT_VARIABLE compile_result
+                  ERROR_VARIABLE compile_error)
+  if(NOT compile_result EQUAL 0)
+    message(FATAL_ERROR "Could not compile ${variant}:\n${compile_error}")
+  endif()
+
+  execute_process(COMMAND ${OBJDUMP} -h ${obj}
+                  OUTPUT_VARIABLE headers
+                  RESULT_VARIABLE objdump_result)
+  if(NOT objdump_result EQUAL 0)
+    message(FATAL_ERROR "Could not read the sections of ${obj}")
+  endif()
+
+  foreach(section IN LISTS sections)
+    set(size_${variant}_${section} 0)
+    string(REPLACE "." "\\." section_re ${section})
+    if(headers MATCHES " ${section_re} +([0-9a-fA-F]+)")
+      math(EXPR size_${variant}_${section} "0x${CMAKE_MATCH_1}")
+    endif()
+  endforeach()
+endforeach()
+
+# report
+foreach(variant guard try_catch)
+  foreach(section IN LISTS sections)
+    math(EXPR added
+         "${size_${variant}_${section}} - ${size_plain_${section}}")
+    math(EXPR hundredths "${added} * 100 / ${COUNT}")
+    if(hundredths LESS 0)
+      set(sign "-")
+      math(EXPR hundredths "0 - ${hundredths}")
+    else()
+      set(sign "+")
+    endif()
+    math(EXPR whole "${hundredths} / 100")
+    math(EXPR fraction "${hundredths} % 100")
+    if(fraction LESS 10)
+      set(fraction "0${fraction}")
+    endif()
+    message(STATUS "${variant}: ${section} ${sign}${whole}.${fraction} "
+                   "bytes per function (${COUNT} functions)")
+  endforeach()
+endforeach()
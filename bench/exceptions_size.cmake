@@ -0,0 +1,52 @@
+# Compares the size of two builds of the same test binary, one with exceptions
+# and one without (-fno-exceptions). It reports the size of each file and of
+# the sections that exceptions affect the most: code and unwind tables.
+#
+# Meant to be run in script mode (cmake -P), with the following definitions:
+#   OBJDUMP - the objdump tool, to read section sizes
+#   WITH    - the binary built with exceptions
+#   WITHOUT - the binary built without exceptions
+
+set(sections .text .eh_frame .eh_frame_hdr .gcc_except_table)
+set(variants WITH WITHOUT)
+
+# read file and section sizes
+foreach(variant IN LISTS variants)
+  file(SIZE ${${variant}} size_${variant}_file)
+
+  execute_process(COMMAND ${OBJDUMP} -h ${${variant}}
+                  OUTPUT_VARIABLE headers
+                  RESULT_VARIABLE objdump_result)
+  if(NOT objdump_result EQUAL 0)
+    message(FATAL_ERROR "Could not read the sections of ${${variant}}")
+  endif()
+
+  foreach(section IN LISTS sections)
+    set(size_${variant}_${section} 0)
+    string(REPLACE "." "\\." section_re ${section})
+    if(headers MATCHES " ${section_re} +([0-9a-fA-F]+)")
+      math(EXPR size_${variant}_${section} "0x${CMAKE_MATCH_1}")
+    endif()
+  endforeach()
+endforeach()
+
+# report
+foreach(part file ${sections})
+  set(with ${size_WITH_${part}})
+  set(without ${size_WITHOUT_${part}})
+  set(change "")
+  if(with GREATER 0)
+    math(EXPR tenths "(${without} - ${with}) * 1000 / ${with}")
+    if(tenths LESS 0)
+      set(sign "-")
+      math(EXPR tenths "0 - ${tenths}")
+    else()
+      set(sign "+")
+    endif()
+    math(EXPR whole "${tenths} / 10")
+    math(EXPR fraction "${tenths} % 10")
+    set(change " (${sign}${whole}.${fraction}%)")
+  endif()
+  message(STATUS "${part}: ${with} bytes with exceptions, ${without} bytes "
+                 "without${change}")
+endforeach()
@@ -0,0 +1,141 @@
+/*
+ *  Created on: 15/10/2026
+ *      Author: ricab
+ *
+ * Benchmarks guard_stack against moving scope_guards into a std::vector.
+ */
+
+#include "bench.hpp"
+#include "guard_stack.hpp"
+#include "scope_guard.hpp"
+
+#include <functional>
+#include <vector>
+
+using namespace sg;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  auto rollback(unsigned& sink, unsigned i) noexcept
+  {
+    return [&sink, i]() noexcept { sink += i; };
+  }
+
+  using rollback_guard =
+    decltype(make_scope_guard(rollback(std::declval<unsigned&>(), 0u)));
+  using function_guard =
+    decltype(make_scope_guard(std::declval<std::function<void()>>()));
+
+  template<std::size_t N, std::size_t Pushes>
+  void guard_stack_unwind(std::size_t iterations)
+  {
+    auto sink = 0u;
+    for(std::size_t it = 0; it < iterations; ++it)
+    {
+      guard_stack<N> stack;
+      for(auto i = 0u; i < Pushes; ++i)
+        stack.push(rollback(sink, i));
+    }
+    bench::do_not_optimize(sink);
+  }
+
+  template<std::size_t N, std::size_t Pushes>
+  void guard_stack_commit(std::size_t iterations)
+  {
+    auto sink = 0u;
+    for(std::size_t it = 0; it < iterations; ++it)
+    {
+      guard_stack<N> stack;
+      for(auto i = 0u; i < Pushes; ++i)
+        stack.push(rollback(sink, i));
+      stack.commit();
+    }
+    bench::do_not_optimize(sink);
+  }
+
+  template<std::size_t Pushes>
+  void vector_unwind(std::size_t iterations)
+  {
+    auto sink = 0u;
+    for(std::size_t it = 0; it < iterations; ++it)
+    {
+      std::vector<rollback_guard> guards;
+      for(auto i = 0u; i < Pushes; ++i)
+        guards.push_back(make_scope_guard(rollback(sink, i)));
+      // note: vector destroys elements in unspecified (usually forward) order
+    }
+    bench::do_not_optimize(sink);
+  }
+
+  template<std::size_t Pushes>
+  void vector_commit(std::size_t iterations)
+  {
+    auto sink = 0u;
+    for(std::size_t it = 0; it < iterations; ++it)
+    {
+      std::vector<rollback_guard> guards;
+      for(auto i = 0u; i < Pushes; ++i)
+        guards.push_back(make_scope_guard(rollback(sink, i)));
+      for(auto& guard : guards)
+        guard.dismiss();
+    }
+    bench::do_not_optimize(sink);
+  }
+
+  template<std::size_t Pushes>
+  void function_vector_unwind(std::size_t iterations)
+  {
+    auto sink = 0u;
+    for(std::size_t it = 0; it < iterations; ++it)
+    {
+      std::vector<function_guard> guards;
+      for(auto i = 0u; i < Pushes; ++i)
+        guards.push_back(
+          make_scope_guard(std::function<void()>{rollback(sink, i)}));
+    }
+    bench::do_not_optimize(sink);
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("guard_stack<8>/push_8/unwind")
+{
+  guard_stack_unwind<8, 8>(iterations);
+}
+SG_BENCHMARK("guard_stack<8>/push_8/commit")
+{
+  guard_stack_commit<8, 8>(iterations);
+}
+SG_BENCHMARK("guard_stack<8>/push_64/unwind")
+{
+  guard_stack_unwind<8, 64>(iterations);
+}
+SG_BENCHMARK("guard_stack<8>/push_64/commit")
+{
+  guard_stack_commit<8, 64>(iterations);
+}
+SG_BENCHMARK("vector<scope_guard>/push_8/unwind")
+{
+  vector_unwind<8>(iterations);
+}
+SG_BENCHMARK("vector<scope_guard>/push_8/commit")
+{
+  vector_commit<8>(iterations);
+}
+SG_BENCHMARK("vector<scope_guard>/push_64/unwind")
+{
+  vector_unwind<64>(iterations);
+}
+SG_BENCHMARK("vector<scope_guard>/push_64/commit")
+{
+  vector_commit<64>(iterations);
+}
+SG_BENCHMARK("vector<scope_guard<function>>/push_8/unwind")
+{
+  function_vector_unwind<8>(iterations);
+}
+SG_BENCHMARK("vector<scope_guard<function>>/push_64/unwind")
+{
+  function_vector_unwind<64>(iterations);
+}
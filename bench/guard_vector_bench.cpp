@@ -0,0 +1,102 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * Benchmarks growing containers to a million guards, without reserving:
+ * guard_vector, which relocates trivially relocatable guards with realloc (or
+ * moves the others one by one), against std::vector, which always moves.
+ */
+
+#include "bench.hpp"
+#include "guard_vector.hpp"
+#include "scope_guard.hpp"
+
+#include <vector>
+
+using namespace sg;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  constexpr auto guards_per_iteration = 1000000u;
+
+  auto rollback(unsigned& sink, unsigned i) noexcept
+  {
+    return [&sink, i]() noexcept { sink += i; };
+  }
+
+  struct moving_rollback // the same, but not trivially copyable
+  {
+    moving_rollback(unsigned& sink, unsigned i) noexcept
+      : m_sink{&sink}
+      , m_i{i}
+    {}
+
+    moving_rollback(moving_rollback&& other) noexcept
+      : m_sink{other.m_sink}
+      , m_i{other.m_i}
+    {}
+
+    void operator()() const noexcept { *m_sink += m_i; }
+
+    unsigned* m_sink;
+    unsigned m_i;
+  };
+
+  using rollback_guard =
+    decltype(make_scope_guard(rollback(std::declval<unsigned&>(), 0u)));
+  using moving_rollback_guard = detail::scope_guard<moving_rollback>;
+
+  static_assert(guard_vector<rollback_guard>::relocates_bitwise,
+                "rollback guards should be relocated bitwise");
+  static_assert(!guard_vector<moving_rollback_guard>::relocates_bitwise,
+                "moving_rollback guards should be moved");
+
+  template<typename Container>
+  void grow(std::size_t iterations)
+  {
+    auto sink = 0u;
+    for(std::size_t it = 0; it < iterations; ++it)
+    {
+      Container guards;
+      for(auto i = 0u; i < guards_per_iteration; ++i)
+        guards.push_back(make_scope_guard(rollback(sink, i)));
+      for(auto i = std::size_t{0}; i < guards.size(); ++i)
+        guards[i].dismiss();
+    }
+    bench::do_not_optimize(sink);
+  }
+
+  template<typename Container>
+  void grow_moving(std::size_t iterations)
+  {
+    auto sink = 0u;
+    for(std::size_t it = 0; it < iterations; ++it)
+    {
+      Container guards;
+      for(auto i = 0u; i < guards_per_iteration; ++i)
+        guards.push_back(make_scope_guard(moving_rollback{sink, i}));
+      for(auto i = std::size_t{0}; i < guards.size(); ++i)
+        guards[i].dismiss();
+    }
+    bench::do_not_optimize(sink);
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("guard_vector<relocatable>/grow_1M")
+{
+  grow<guard_vector<rollback_guard>>(iterations);
+}
+SG_BENCHMARK("vector<relocatable>/grow_1M")
+{
+  grow<std::vector<rollback_guard>>(iterations);
+}
+SG_BENCHMARK("guard_vector<moved>/grow_1M")
+{
+  grow_moving<guard_vector<moving_rollback_guard>>(iterations);
+}
+SG_BENCHMARK("vector<moved>/grow_1M")
+{
+  grow_moving<std::vector<moving_rollback_guard>>(iterations);
+}
@@ -0,0 +1,55 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * Benchmarks latency guards: the cost of timing a scope with each tick source,
+ * i.e. reading the clock twice and recording in this thread's histogram, and
+ * the cost of recording alone. The histograms are warmed up beforehand, so no
+ * allocation is measured.
+ */
+
+#include "bench.hpp"
+#include "latency_guard.hpp"
+
+#include <cstdint>
+
+using namespace sg;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  latency_site steady_site{"bench/steady"};
+  latency_site tsc_site{"bench/tsc"};
+  latency_site record_site{"bench/record"};
+
+  template<typename Ticks>
+  void time_scopes(std::size_t iterations, const latency_site& site)
+  {
+    for(std::size_t it = 0; it < iterations; ++it)
+    {
+      auto guard = make_latency_guard<Ticks>(site);
+      bench::do_not_optimize(guard);
+    }
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("latency_guard/time_scope/steady_ticks")
+{
+  time_scopes<steady_ticks>(iterations, steady_site);
+}
+#ifdef SG_HAS_TSC
+SG_BENCHMARK("latency_guard/time_scope/tsc_ticks")
+{
+  time_scopes<tsc_ticks>(iterations, tsc_site);
+}
+#endif
+SG_BENCHMARK("latency_guard/record_only")
+{
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    auto ticks = static_cast<std::uint64_t>(it & 1023u); // various buckets
+    bench::do_not_optimize(ticks);
+    detail::record_latency(record_site.id(), ticks);
+  }
+}
@@ -0,0 +1,89 @@
+# Compares the time to build a synthetic project whose COUNT translation units
+# use scope guards, in two variants:
+#   header - each translation unit includes scope_guard.hpp
+#   module - each translation unit imports the sg module (built once, first)
+# Each translation unit has a few functions, each with a guard over a distinct
+# lambda. They are compiled to object files, one at a time, with -O2, and the
+# total time of each variant is reported (for the module variant, with and
+# without the time to build the module itself).
+#
+# Meant to be run in script mode (cmake -P), with the following definitions:
+#   COMPILER - the C++ compiler, which must be GCC (for -fmodules-ts)
+#   INCLUDE  - the directory with scope_guard.hpp and scope_guard.cppm
+#   WORK_DIR - where to write sources, objects and the module
+#   COUNT    - (optional) the number of translation units, 64 by default
+
+cmake_minimum_required(VERSION 3.23) # for microseconds in string(TIMESTAMP)
+
+if(NOT DEFINED COUNT)
+  set(COUNT 64)
+endif()
+
+set(flags -std=c++20 -fmodules-ts -O2 -fmodule-mapper=${WORK_DIR}/sg.map)
+set(variants header module)
+
+# generate the sources
+file(WRITE ${WORK_DIR}/sg.map "sg ${WORK_DIR}/sg.gcm\n")
+math(EXPR last "${COUNT} - 1")
+foreach(variant IN LISTS variants)
+  foreach(i RANGE ${last})
+    if(variant STREQUAL "header")
+      set(src "#include \"scope_guard.hpp\"\n")
+    else()
+      set(src "import sg;\n")
+    endif()
+    string(APPEND src "void sg_build_work(int);\n") # opaque, may throw
+    foreach(j RANGE 3)
+      string(APPEND src "void sg_build_f${i}_${j}(int* p)\n{\n"
+                        "  const auto guard = sg::make_scope_guard("
+                        "[p]() noexcept { *p = ${j}; });\n"
+                        "  const auto fail = sg::make_scope_fail("
+                        "[p]() noexcept { *p = -${j}; });\n"
+                        "  sg_build_work(${j});\n}\n")
+    endforeach()
+    file(WRITE ${WORK_DIR}/module_build_${variant}_${i}.cpp "${src}")
+  endforeach()
+endforeach()
+
+# compiles one source, or stops on failure
+function(compile src obj)
+  execute_process(COMMAND ${COMPILER} ${flags} ${ARGN} -c -o ${obj} ${src}
+                  WORKING_DIRECTORY ${WORK_DIR}
+                  RESULT_VARIABLE compile_result
+                  ERROR_VARIABLE compile_error)
+  if(NOT compile_result EQUAL 0)
+    message(FATAL_ERROR "Could not compile ${src}:\n${compile_error}")
+  endif()
+endfunction()
+
+# the time elapsed since start, in milliseconds
+function(elapsed_ms ret start)
+  string(TIMESTAMP now "%s%f")
+  math(EXPR ms "(${now} - ${start}) / 1000")
+  set(${ret} ${ms} PARENT_SCOPE)
+endfunction()
+
+# build the module
+string(TIMESTAMP start "%s%f")
+compile(${INCLUDE}/scope_guard.cppm ${WORK_DIR}/sg.o -I${INCLUDE} -x c++)
+elapsed_ms(interface_ms ${start})
+
+# build the translation units of each variant
+foreach(variant IN LISTS variants)
+  string(TIMESTAMP start "%s%f")
+  foreach(i RANGE ${last})
+    compile(${WORK_DIR}/module_build_${variant}_${i}.cpp
+            ${WORK_DIR}/module_build_${variant}_${i}.o -I${INCLUDE})
+  endforeach()
+  elapsed_ms(${variant}_ms ${start})
+endforeach()
+
+# report
+math(EXPR total_ms "${module_ms} + ${interface_ms}")
+math(EXPR header_tu_ms "${header_ms} / ${COUNT}")
+math(EXPR module_tu_ms "${module_ms} / ${COUNT}")
+message(STATUS "header: ${header_ms} ms (${header_tu_ms} ms per translation "
+               "unit, ${COUNT} translation units)")
+message(STATUS "module: ${module_ms} ms (${module_tu_ms} ms per translation "
+               "unit), ${total_ms} ms with the module itself "
+               "(${interface_ms} ms)")
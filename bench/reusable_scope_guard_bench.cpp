@@ -0,0 +1,96 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * Benchmarks reusing the slots of a fixed ring of guards: reset on a
+ * reusable_scope_guard, against std::optional<scope_guard> (reset and emplace)
+ * and std::unique_ptr<scope_guard> (a new guard per use).
+ */
+
+#include "bench.hpp"
+#include "reusable_scope_guard.hpp"
+#include "scope_guard.hpp"
+
+#include <array>
+#include <memory>
+#include <optional>
+
+using namespace sg;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  constexpr auto ring_size = 8u;
+
+  auto rollback(unsigned& sink, unsigned i) noexcept
+  {
+    return [&sink, i]() noexcept { sink += i; };
+  }
+
+  using rollback_t = decltype(rollback(std::declval<unsigned&>(), 0u));
+  using rollback_guard = decltype(make_scope_guard(std::declval<rollback_t>()));
+
+  template<on_replace Policy>
+  void ring_reset(std::size_t iterations)
+  {
+    auto sink = 0u;
+    {
+      std::array<reusable_scope_guard<rollback_t, Policy>, ring_size> ring;
+      for(std::size_t it = 0; it < iterations; ++it)
+      {
+        const auto i = static_cast<unsigned>(it);
+        ring[i % ring_size].reset(rollback(sink, i));
+      }
+    }
+    bench::do_not_optimize(sink);
+  }
+
+  void ring_optional(std::size_t iterations)
+  {
+    auto sink = 0u;
+    {
+      std::array<std::optional<rollback_guard>, ring_size> ring;
+      for(std::size_t it = 0; it < iterations; ++it)
+      {
+        const auto i = static_cast<unsigned>(it);
+        auto& slot = ring[i % ring_size];
+        slot.reset();
+        slot.emplace(make_scope_guard(rollback(sink, i)));
+      }
+    }
+    bench::do_not_optimize(sink);
+  }
+
+  void ring_unique_ptr(std::size_t iterations)
+  {
+    auto sink = 0u;
+    {
+      std::array<std::unique_ptr<rollback_guard>, ring_size> ring;
+      for(std::size_t it = 0; it < iterations; ++it)
+      {
+        const auto i = static_cast<unsigned>(it);
+        ring[i % ring_size].reset(
+          new rollback_guard{make_scope_guard(rollback(sink, i))});
+      }
+    }
+    bench::do_not_optimize(sink);
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("reusable_scope_guard<fire>/ring_8/reset")
+{
+  ring_reset<on_replace::fire>(iterations);
+}
+SG_BENCHMARK("reusable_scope_guard<discard>/ring_8/reset")
+{
+  ring_reset<on_replace::discard>(iterations);
+}
+SG_BENCHMARK("optional<scope_guard>/ring_8/reset_emplace")
+{
+  ring_optional(iterations);
+}
+SG_BENCHMARK("unique_ptr<scope_guard>/ring_8/reset_new")
+{
+  ring_unique_ptr(iterations);
+}
@@ -0,0 +1,57 @@
+/*
+ *  Created on: 15/10/2026
+ *      Author: ricab
+ *
+ * Benchmarks the cost of scope_fail and scope_success on the non-throwing path,
+ * with the counter from std::uncaught_exceptions, against dismissing by hand.
+ * See scope_fail_cxxabi_bench.cpp for the counter from the C++ ABI.
+ */
+
+#include "bench.hpp"
+#include "scope_guard.hpp"
+
+#include <exception>
+
+using namespace sg;
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("std::uncaught_exceptions")
+{
+  auto sink = 0;
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    sink += std::uncaught_exceptions();
+    bench::do_not_optimize(sink);
+  }
+}
+SG_BENCHMARK("scope_fail/std/normal_exit")
+{
+  auto sink = 0u;
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    const auto guard = make_scope_fail([&sink]() noexcept { sink = 0; });
+    bench::do_not_optimize(sink); // the work
+  }
+  bench::do_not_optimize(sink);
+}
+SG_BENCHMARK("scope_success/std/normal_exit")
+{
+  auto sink = 0u;
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    const auto guard = make_scope_success([&sink]() noexcept { ++sink; });
+    bench::do_not_optimize(sink); // the work
+  }
+  bench::do_not_optimize(sink);
+}
+SG_BENCHMARK("scope_guard+dismiss/normal_exit")
+{
+  auto sink = 0u;
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    auto guard = make_scope_guard([&sink]() noexcept { sink = 0; });
+    bench::do_not_optimize(sink); // the work
+    guard.dismiss();
+  }
+  bench::do_not_optimize(sink);
+}
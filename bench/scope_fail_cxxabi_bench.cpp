@@ -0,0 +1,47 @@
+/*
+ *  Created on: 15/10/2026
+ *      Author: ricab
+ *
+ * Benchmarks scope_fail and scope_success on the non-throwing path, with the
+ * thread-local counter read through the C++ ABI. Only this file uses the
+ * option; the counter is part of the guards' type, so there is no ODR clash
+ * with scope_fail_bench.cpp.
+ */
+
+#define SG_UNCAUGHT_EXCEPTIONS_FROM_CXXABI
+
+#include "bench.hpp"
+#include "scope_guard.hpp"
+
+using namespace sg;
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("cxxabi_exception_counter::count")
+{
+  auto sink = 0;
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    sink += detail::cxxabi_exception_counter::count();
+    bench::do_not_optimize(sink);
+  }
+}
+SG_BENCHMARK("scope_fail/cxxabi/normal_exit")
+{
+  auto sink = 0u;
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    const auto guard = make_scope_fail([&sink]() noexcept { sink = 0; });
+    bench::do_not_optimize(sink); // the work
+  }
+  bench::do_not_optimize(sink);
+}
+SG_BENCHMARK("scope_success/cxxabi/normal_exit")
+{
+  auto sink = 0u;
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    const auto guard = make_scope_success([&sink]() noexcept { ++sink; });
+    bench::do_not_optimize(sink); // the work
+  }
+  bench::do_not_optimize(sink);
+}
@@ -0,0 +1,164 @@
+/*
+ *  Created on: 15/10/2026
+ *      Author: ricab
+ *
+ * Benchmarks the basic operations of scope_guard: construction (followed by
+ * destruction, which executes the callback) for each category of callback that
+ * catch_tests.cpp covers, move construction, dismissal and the exception path.
+ */
+
+#include "bench.hpp"
+#include "scope_guard.hpp"
+
+#include <functional>
+#include <utility>
+
+using namespace sg;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  unsigned ticks = 0u;
+
+  void tick() noexcept
+  {
+    ++ticks;
+  }
+
+  void tick_by(unsigned& n) noexcept
+  {
+    ++n;
+  }
+
+  struct ticking_functor
+  {
+    void operator()() const noexcept { tick(); }
+  };
+
+  template<typename MakeCallback>
+  void construct_destroy(std::size_t iterations, MakeCallback make_callback)
+  {
+    for(std::size_t it = 0; it < iterations; ++it)
+    {
+      auto guard = make_scope_guard(make_callback());
+      bench::do_not_optimize(guard);
+    }
+    bench::do_not_optimize(ticks);
+  }
+} // namespace
+
+/* --- Construction and destruction, per callback category --- */
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("scope_guard/construct/function")
+{
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    auto guard = make_scope_guard(tick);
+    bench::do_not_optimize(guard);
+  }
+  bench::do_not_optimize(ticks);
+}
+SG_BENCHMARK("scope_guard/construct/function_pointer")
+{
+  construct_destroy(iterations, []() { return &tick; });
+}
+SG_BENCHMARK("scope_guard/construct/reference_to_functor")
+{
+  const ticking_functor functor{};
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    auto guard = make_scope_guard(functor);
+    bench::do_not_optimize(guard);
+  }
+  bench::do_not_optimize(ticks);
+}
+SG_BENCHMARK("scope_guard/construct/std::function")
+{
+  construct_destroy(iterations, []() { return std::function<void()>{tick}; });
+}
+SG_BENCHMARK("scope_guard/construct/lambda")
+{
+  construct_destroy(iterations, []() { return []() noexcept { tick(); }; });
+}
+SG_BENCHMARK("scope_guard/construct/bind")
+{
+  construct_destroy(iterations,
+                    []() { return std::bind(tick_by, std::ref(ticks)); });
+}
+SG_BENCHMARK("scope_guard/construct/functor")
+{
+  construct_destroy(iterations, []() { return ticking_functor{}; });
+}
+
+/* --- Move construction --- */
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("scope_guard/move/lambda")
+{
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    auto guard = make_scope_guard([]() noexcept { tick(); });
+    bench::do_not_optimize(guard);
+    auto moved = std::move(guard);
+    bench::do_not_optimize(moved);
+  }
+  bench::do_not_optimize(ticks);
+}
+SG_BENCHMARK("scope_guard/move/std::function")
+{
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    auto guard = make_scope_guard(std::function<void()>{tick});
+    bench::do_not_optimize(guard);
+    auto moved = std::move(guard);
+    bench::do_not_optimize(moved);
+  }
+  bench::do_not_optimize(ticks);
+}
+
+/* --- Dismissal --- */
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("scope_guard/dismiss/lambda")
+{
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    auto guard = make_scope_guard([]() noexcept { tick(); });
+    bench::do_not_optimize(guard);
+    guard.dismiss();
+  }
+  bench::do_not_optimize(ticks);
+}
+
+/* --- Exception path --- */
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("exception/throw+catch/no_guard")
+{
+  for(std::size_t it = 0; it < iterations; ++it)
+    try
+    {
+      bench::do_not_optimize(it);
+      throw 42;
+    }
+    catch(int)
+    {
+      tick();
+    }
+  bench::do_not_optimize(ticks);
+}
+SG_BENCHMARK("exception/throw+catch/scope_guard_unwind")
+{
+  for(std::size_t it = 0; it < iterations; ++it)
+    try
+    {
+      const auto guard = make_scope_guard([]() noexcept { tick(); });
+      bench::do_not_optimize(it);
+      throw 42;
+    }
+    catch(int)
+    {
+    }
+  bench::do_not_optimize(ticks);
+}
@@ -0,0 +1,22 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * Benchmarks enabled trace zones: the cost of an empty zone, i.e. reading the
+ * clock twice and writing two events in this thread's ring buffer, which wraps
+ * around. The buffer is claimed beforehand, so no allocation is measured.
+ * Disabled zones are checked to compile to nothing by the codegen tests.
+ */
+
+#define SG_ENABLE_TRACE
+#include "bench.hpp"
+#include "trace_zone.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("trace_zone/empty_zone")
+{
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    SG_TRACE_ZONE("bench/empty");
+  }
+}
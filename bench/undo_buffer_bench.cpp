@@ -0,0 +1,164 @@
+/*
+ *  Created on: 15/10/2026
+ *      Author: ricab
+ *
+ * Benchmarks rolling back 1e6 element writes with undo_buffer against one
+ * scope_guard per write, and nested undo_scopes against nested scope_guards.
+ */
+
+#include "bench.hpp"
+#include "guard_stack.hpp"
+#include "scope_guard.hpp"
+#include "undo_buffer.hpp"
+
+#include <vector>
+
+using namespace sg;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  constexpr std::size_t elements = 1000000;
+
+  std::vector<int>& data()
+  {
+    static std::vector<int> values(elements, 1);
+    return values;
+  }
+
+  auto restore(int& element, int old) noexcept
+  {
+    return [&element, old]() noexcept { element = old; };
+  }
+
+  using restore_guard = decltype(make_scope_guard(restore(data()[0], 0)));
+
+  constexpr unsigned depth = 8; // nesting levels, each writing one element
+
+  void nested_scopes(undo_buffer& undo, int* values, unsigned level)
+  {
+    if(level < depth)
+    {
+      undo_scope scope{undo};
+      undo.record(values[level]);
+      ++values[level];
+      nested_scopes(undo, values, level + 1);
+      if(level % 2) // commit odd levels, roll back even ones
+        scope.commit();
+    }
+  }
+
+  void nested_guards(int* values, unsigned level)
+  {
+    if(level < depth)
+    {
+      auto guard = make_scope_guard(restore(values[level], values[level]));
+      ++values[level];
+      nested_guards(values, level + 1);
+      if(level % 2)
+        guard.dismiss();
+    }
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("undo_buffer/1e6_writes/rollback")
+{
+  auto& values = data();
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    undo_buffer undo;
+    for(auto& value : values)
+    {
+      undo.record(value);
+      ++value;
+    }
+  }
+  bench::do_not_optimize(values);
+}
+SG_BENCHMARK("undo_buffer/1e6_writes/commit")
+{
+  auto& values = data();
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    undo_buffer undo;
+    for(auto& value : values)
+    {
+      undo.record(value);
+      ++value;
+    }
+    undo.commit();
+  }
+  bench::do_not_optimize(values);
+}
+SG_BENCHMARK("undo_buffer/1e6_backward_writes/rollback") // no merging
+{
+  auto& values = data();
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    undo_buffer undo;
+    for(auto i = values.size(); i-- > 0;)
+    {
+      undo.record(values[i]);
+      ++values[i];
+    }
+  }
+  bench::do_not_optimize(values);
+}
+SG_BENCHMARK("undo_buffer/1e6_elements_in_one_record/rollback")
+{
+  auto& values = data();
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    undo_buffer undo;
+    undo.record(values.data(), values.size() * sizeof(int));
+    for(auto& value : values)
+      ++value;
+  }
+  bench::do_not_optimize(values);
+}
+SG_BENCHMARK("vector<scope_guard>/1e6_writes/rollback")
+{
+  auto& values = data();
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    std::vector<restore_guard> guards;
+    for(auto& value : values)
+    {
+      guards.push_back(make_scope_guard(restore(value, value)));
+      ++value;
+    }
+    // note: restores in forward order, which is fine for distinct elements
+  }
+  bench::do_not_optimize(values);
+}
+SG_BENCHMARK("guard_stack<16>/1e6_writes/rollback")
+{
+  auto& values = data();
+  for(std::size_t it = 0; it < iterations; ++it)
+  {
+    guard_stack<16> guards;
+    for(auto& value : values)
+    {
+      guards.push(restore(value, value));
+      ++value;
+    }
+  }
+  bench::do_not_optimize(values);
+}
+SG_BENCHMARK("undo_scope/depth_8")
+{
+  int values[depth] = {};
+  undo_buffer undo;
+  undo.reserve(1024); // in steady state, the arena is reused
+  for(std::size_t it = 0; it < iterations; ++it)
+    nested_scopes(undo, values, 0u);
+  bench::do_not_optimize(values);
+}
+SG_BENCHMARK("scope_guard/depth_8")
+{
+  int values[depth] = {};
+  for(std::size_t it = 0; it < iterations; ++it)
+    nested_guards(values, 0u);
+  bench::do_not_optimize(values);
+}
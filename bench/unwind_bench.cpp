@@ -0,0 +1,126 @@
+/*
+ *  Created on: 15/10/2026
+ *      Author: ricab
+ *
+ * Benchmarks throwing through a chain of nested frames, each of which rolls
+ * back its own step, either with a scope_guard or with a try/catch that
+ * rethrows. Times are per frame: each benchmark iteration is one frame, so a
+ * throw through depth D frames counts as D iterations (with a shallower last
+ * throw, when the iterations are not a multiple of D).
+ * See eh_size.cmake for the size of unwind tables added per guard.
+ */
+
+#include "bench.hpp"
+#include "scope_guard.hpp"
+
+#include <stdexcept>
+
+using namespace sg;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  unsigned steps = 0u; // done, and not rolled back
+
+  SG_BENCH_NOINLINE void do_step() noexcept
+  {
+    ++steps;
+  }
+
+  SG_BENCH_NOINLINE void undo_step() noexcept
+  {
+    --steps;
+  }
+
+  SG_BENCH_NOINLINE void fail()
+  {
+    if(steps) // always, but the compiler must not assume that fail never returns
+      throw std::runtime_error{"failure deep in the call chain"};
+  }
+
+  SG_BENCH_NOINLINE void guarded_level(unsigned depth)
+  {
+    do_step();
+    const auto guard = make_scope_guard(undo_step);
+    if(depth > 1)
+      guarded_level(depth - 1);
+    else
+      fail();
+  }
+
+  SG_BENCH_NOINLINE void try_catch_level(unsigned depth)
+  {
+    do_step();
+    try
+    {
+      if(depth > 1)
+        try_catch_level(depth - 1);
+      else
+        fail();
+    }
+    catch(...)
+    {
+      undo_step();
+      throw;
+    }
+  }
+
+  template<void (*Level)(unsigned)>
+  void unwind(unsigned depth)
+  {
+    try
+    {
+      Level(depth);
+    }
+    catch(const std::runtime_error&)
+    {
+    }
+  }
+
+  /* Unwinds exactly the given number of frames: throws through depth frames
+  as many times as fit, then once through the remainder, if any */
+  template<void (*Level)(unsigned)>
+  void unwind_per_frame(std::size_t frames, unsigned depth)
+  {
+    for(auto throws = frames / depth; throws > 0; --throws)
+      unwind<Level>(depth);
+    if(const auto rest = static_cast<unsigned>(frames % depth))
+      unwind<Level>(rest);
+
+    bench::do_not_optimize(steps); // back to 0
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+SG_BENCHMARK("unwind/scope_guard/depth_1/per_frame")
+{
+  unwind_per_frame<guarded_level>(iterations, 1u);
+}
+SG_BENCHMARK("unwind/try_catch/depth_1/per_frame")
+{
+  unwind_per_frame<try_catch_level>(iterations, 1u);
+}
+SG_BENCHMARK("unwind/scope_guard/depth_8/per_frame")
+{
+  unwind_per_frame<guarded_level>(iterations, 8u);
+}
+SG_BENCHMARK("unwind/try_catch/depth_8/per_frame")
+{
+  unwind_per_frame<try_catch_level>(iterations, 8u);
+}
+SG_BENCHMARK("unwind/scope_guard/depth_64/per_frame")
+{
+  unwind_per_frame<guarded_level>(iterations, 64u);
+}
+SG_BENCHMARK("unwind/try_catch/depth_64/per_frame")
+{
+  unwind_per_frame<try_catch_level>(iterations, 64u);
+}
+SG_BENCHMARK("unwind/scope_guard/depth_512/per_frame")
+{
+  unwind_per_frame<guarded_level>(iterations, 512u);
+}
+SG_BENCHMARK("unwind/try_catch/depth_512/per_frame")
+{
+  unwind_per_frame<try_catch_level>(iterations, 512u);
+}
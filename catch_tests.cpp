@@ -4,15 +4,33 @@
  */
 
 #include "scope_guard.hpp"
+#include "any_scope_guard.hpp"
+#include "atomic_scope_guard.hpp"
+#include "cold_scope_guard.hpp"
+#include "guard_stack.hpp"
+#include "guard_vector.hpp"
+#include "latency_guard.hpp"
+#include "reusable_scope_guard.hpp"
+#define SG_ENABLE_TRACE
+#include "trace_zone.hpp"
+#include "undo_buffer.hpp"
 
 #define CATCH_CONFIG_MAIN  // This tells Catch to provide a main()
 #include "catch/catch.hpp"
 
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <list>
 #include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <system_error>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 using namespace sg;
 
@@ -1631,6 +1649,71 @@ TEST_CASE("Example usage relying on SFINAE-friendliness")
 #endif
 }
 
+#ifdef SG_HAS_CONCEPTS
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  template<typename Stream>
+  auto get_constrained_closing_guard(Stream& s)
+  {
+    if constexpr(sg::scope_guard_callback<sclosr<Stream>>)
+      return make_scope_guard(sclosr<Stream>{s});
+    else
+      return make_scope_guard(fallback);
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Example usage relying on the scope_guard_callback concept")
+{
+  {
+    good_stream s;
+    auto guard = get_constrained_closing_guard(s);
+  }
+  REQUIRE(goodbye_said);
+
+  {
+    bad_stream s;
+    auto guard = get_constrained_closing_guard(s);
+  }
+  REQUIRE_FALSE(goodbye_said);
+
+  {
+    uncertain_stream s;
+    auto guard = get_constrained_closing_guard(s);
+  }
+#ifdef SG_REQUIRE_NOEXCEPT
+  REQUIRE_FALSE(goodbye_said);
+#else
+  REQUIRE(goodbye_said);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("The scope_guard_callback concept is satisfied exactly by the "
+          "callbacks that make_scope_guard accepts")
+{
+  static_assert(sg::scope_guard_callback<void(&)() noexcept>);
+  static_assert(sg::scope_guard_callback<sclosr<good_stream>>);
+  static_assert(!sg::scope_guard_callback<sclosr<bad_stream>>);
+  static_assert(!sg::scope_guard_callback<int>);
+  static_assert(!sg::scope_guard_callback<void(*)(int) noexcept>);
+#ifdef SG_REQUIRE_NOEXCEPT
+  static_assert(!sg::scope_guard_callback<sclosr<uncertain_stream>>);
+#else
+  static_assert(sg::scope_guard_callback<sclosr<uncertain_stream>>);
+#endif
+
+  struct throwing_dtor
+  {
+    void operator()() const noexcept {}
+    ~throwing_dtor() noexcept(false) {}
+  };
+  static_assert(!sg::scope_guard_callback<throwing_dtor>);
+  static_assert(sg::scope_guard_callback<throwing_dtor&>); // not destroyed
+}
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 namespace
 {
@@ -2220,3 +2303,2376 @@ TEST_CASE("Test rollback due to return")
   REQUIRE(fake_returning_undo(true));
   REQUIRE_FALSE(is_fake_done);
 }
+
+/* --- flagless scope_exit --- */
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A plain-function-based scope_exit executes the function exactly "
+          "once when leaving scope.")
+{
+  reset();
+
+  {
+    const auto guard = make_scope_exit(inc);
+    REQUIRE_FALSE(count);
+  }
+
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A capturing-lambda-based scope_exit executes the lambda exactly once "
+          "when leaving scope.")
+{
+  auto lambda_count = 0u;
+
+  {
+    const auto guard =
+      make_scope_exit([&lambda_count]() noexcept { incc(lambda_count); });
+    REQUIRE_FALSE(lambda_count);
+  }
+
+  REQUIRE(lambda_count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A scope_exit executes its callback exactly once when leaving scope "
+          "due to an exception")
+{
+  fake_do();
+
+  try
+  {
+    const auto guard = make_scope_exit(fake_undo);
+    throw "foobar";
+  }
+  catch(...)
+  {
+    REQUIRE_FALSE(is_fake_done);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A scope_exit is no larger than its callback")
+{
+  auto c = 0u;
+  const auto capturing = [&c]() noexcept { incc(c); };
+  const auto stateless = []() noexcept { inc(); };
+
+  static_assert(sizeof(make_scope_exit(capturing)) == sizeof(&capturing),
+                "scope_exit holding a reference is larger than a pointer");
+  static_assert(sizeof(make_scope_exit(std::move(capturing))) ==
+                sizeof(capturing),
+                "scope_exit holding a lambda is larger than the lambda");
+  static_assert(sizeof(make_scope_exit(StatefulFunctor{c})) ==
+                sizeof(StatefulFunctor),
+                "scope_exit holding a functor is larger than the functor");
+  static_assert(sizeof(make_scope_exit(std::move(stateless))) ==
+                sizeof(stateless),
+                "scope_exit holding a stateless lambda is not empty-sized");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A scope_exit exposes its callback type")
+{
+  const auto lambda = []() noexcept { inc(); };
+  using guard_type = decltype(make_scope_exit(lambda));
+  static_assert(std::is_same<guard_type::callback_type,
+                             decltype(lambda)&>::value,
+                "unexpected scope_exit callback_type");
+}
+
+/* --- layout --- */
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  struct FinalStatelessFunctor final
+  {
+    void operator()() const noexcept { inc(); }
+  };
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Stateless callbacks take no space in a scope_guard")
+{
+  auto stateless = []() noexcept { inc(); };
+
+  static_assert(sizeof(make_scope_guard(std::move(stateless))) == sizeof(bool),
+                "stateless lambda takes space in scope_guard");
+  static_assert(sizeof(make_scope_guard(StatelessFunctor{})) == sizeof(bool),
+                "stateless functor takes space in scope_guard");
+  static_assert(sizeof(make_scope_exit(StatelessFunctor{})) ==
+                sizeof(StatelessFunctor),
+                "stateless functor takes extra space in scope_exit");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Stateful callbacks take no more than their own space in a "
+          "scope_guard")
+{
+  auto c = 0u;
+  auto stateful = [&c]() noexcept { incc(c); };
+
+  static_assert(sizeof(make_scope_guard(std::move(stateful))) <=
+                sizeof(stateful) + alignof(decltype(stateful)),
+                "stateful lambda takes extra space in scope_guard");
+  static_assert(sizeof(make_scope_guard(stateful)) <=
+                sizeof(&stateful) + alignof(decltype(&stateful)),
+                "lambda reference takes extra space in scope_guard");
+  static_assert(sizeof(make_scope_guard(inc)) <=
+                sizeof(&inc) + alignof(decltype(&inc)),
+                "function reference takes extra space in scope_guard");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A scope_guard with a final stateless callback executes the callback "
+          "exactly once when leaving scope.")
+{
+  reset();
+
+  {
+    const auto guard = make_scope_guard(FinalStatelessFunctor{});
+    REQUIRE_FALSE(count);
+  }
+
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A scope_guard with a const stateless callback executes the callback "
+          "exactly once when leaving scope.")
+{
+  reset();
+
+  {
+    const StatelessFunctor functor{};
+    const auto guard = make_scope_guard(std::move(functor));
+    static_assert(std::is_same<decltype(guard)::callback_type,
+                               const StatelessFunctor>::value,
+                  "unexpected callback_type");
+    REQUIRE_FALSE(count);
+  }
+
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A moved stateless-callback-based scope_guard executes the callback "
+          "exactly once, from the moved-to guard")
+{
+  reset();
+
+  {
+    auto source = make_scope_guard(StatelessFunctor{});
+    {
+      const auto dest = std::move(source);
+      REQUIRE_FALSE(count);
+    }
+    REQUIRE(count == 1u);
+  }
+
+  REQUIRE(count == 1u);
+}
+
+/* --- callbacks known at compile time --- */
+
+#if __cplusplus >= 201703L
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A function known at compile time can be used to create a "
+          "scope_guard that executes it exactly once when leaving scope.")
+{
+  reset();
+
+  {
+    const auto guard = make_scope_guard<&inc>();
+    REQUIRE_FALSE(count);
+  }
+
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A dismissed scope_guard created with a function known at compile "
+          "time does not execute its callback at all.")
+{
+  reset();
+
+  {
+    auto guard = make_scope_guard<inc>(); // implicit function to pointer
+    guard.dismiss();
+    REQUIRE_FALSE(count);
+  }
+
+  REQUIRE_FALSE(count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A scope_guard created with a function known at compile time does "
+          "not store a function pointer")
+{
+  static_assert(sizeof(make_scope_guard<&inc>()) == sizeof(bool),
+                "compile-time function pointer takes space in scope_guard");
+  static_assert(noexcept(make_scope_guard<&inc>()),
+                "make_scope_guard not noexcept");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A method known at compile time can be used to create a "
+          "scope_guard that executes it on the provided object exactly once "
+          "when leaving scope.")
+{
+  regular_method_holder h{};
+
+  {
+    const auto guard =
+      make_scope_guard<&regular_method_holder::regular_inc_method>(h);
+    REQUIRE_FALSE(h.m_count);
+  }
+
+  REQUIRE(h.m_count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A const method known at compile time can be used to create a "
+          "scope_guard with a const object.")
+{
+  const const_method_holder h{};
+
+  {
+    const auto guard =
+      make_scope_guard<&const_method_holder::const_inc_method>(h);
+    REQUIRE_FALSE(h.m_count);
+  }
+
+  REQUIRE(h.m_count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A virtual method known at compile time is dispatched dynamically "
+          "by the scope_guard.")
+{
+  virtual_method_holder h{};
+
+  {
+    virtual_method_holder_pure_base& base = h;
+    const auto guard =
+      make_scope_guard<&virtual_method_holder_pure_base::virtual_inc_method>(
+        base);
+    REQUIRE_FALSE(h.m_count);
+  }
+
+  REQUIRE(h.m_count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A scope_guard created with a method known at compile time stores "
+          "only the object pointer")
+{
+  regular_method_holder h{};
+  static_assert(
+    sizeof(make_scope_guard<&regular_method_holder::regular_inc_method>(h)) <=
+    2 * sizeof(&h), "method pointer takes space in scope_guard");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  int returning_noexcept() noexcept { return 42; }
+
+  template<auto F>
+  auto static_sfinae_tester_impl(tag_prefered_overload&& /*ignored*/)
+  -> decltype(make_scope_guard<F>(), std::declval<void>())
+  {
+    make_scope_guard<F>();
+  }
+
+  template<auto F>
+  void static_sfinae_tester_impl(... /* less specific, so 2nd choice */)
+  {
+    make_scope_guard(inc);
+  }
+
+  template<auto F>
+  void static_sfinae_tester()
+  {
+    static_sfinae_tester_impl<F>(tag_prefered_overload{}); // see sfinae_tester
+  }
+
+  template<auto M, typename O>
+  auto static_method_sfinae_tester_impl(O& o, tag_prefered_overload&& /**/)
+  -> decltype(make_scope_guard<M>(o), std::declval<void>())
+  {
+    make_scope_guard<M>(o);
+  }
+
+  template<auto M, typename O>
+  void static_method_sfinae_tester_impl(O& /*ignored*/, ... /* 2nd choice */)
+  {
+    make_scope_guard(inc);
+  }
+
+  template<auto M, typename O>
+  void static_method_sfinae_tester(O& o)
+  {
+    static_method_sfinae_tester_impl<M>(o, tag_prefered_overload{});
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When making a scope_guard with a function known at compile time, a "
+          "substitution failure caused by an improper callback can be "
+          "recovered from without a compilation error")
+{
+  reset();
+
+  static_sfinae_tester<&noop>(); // does not affect count
+  REQUIRE_FALSE(count);
+
+  static_sfinae_tester<&incc>(); // takes arguments
+  REQUIRE(count == 1u);
+
+  static_sfinae_tester<&returning_noexcept>(); // returns non-void
+  REQUIRE(count == 2u);
+
+  static_sfinae_tester<&count>(); // not callable
+  REQUIRE(count == 3u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When making a scope_guard with a method known at compile time, a "
+          "substitution failure caused by an improper method can be "
+          "recovered from without a compilation error")
+{
+  reset();
+
+  regular_method_holder h{};
+  static_method_sfinae_tester<&regular_method_holder::regular_inc_method>(h);
+  REQUIRE(h.m_count == 1u);
+  REQUIRE_FALSE(count);
+
+  const regular_method_holder ch{}; // non-const method on const object
+  static_method_sfinae_tester<&regular_method_holder::regular_inc_method>(ch);
+  REQUIRE(count == 1u);
+
+  static_method_sfinae_tester<&const_method_holder::const_inc_method>(h);
+  REQUIRE(count == 2u); // method of unrelated type
+}
+#endif
+
+/* --- multiple callbacks in a single scope_guard --- */
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  unsigned recorded_order = 0u;
+  void record_order(unsigned digit) noexcept
+  {
+    recorded_order = recorded_order * 10u + digit;
+  }
+
+  struct RecordingFunctor
+  {
+    void operator()() const noexcept { record_order(3u); }
+  };
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Several callbacks of different kinds can be used to create a "
+          "single scope_guard.")
+{
+  const auto lambda = []() noexcept { inc(); };
+  make_scope_guard(inc, lambda, StatelessFunctor{}, std::move(lambda));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A multi-callback scope_guard executes each callback exactly once, "
+          "in reverse order, when leaving scope.")
+{
+  recorded_order = 0u;
+
+  {
+    const auto guard = make_scope_guard([]() noexcept { record_order(1u); },
+                                        []() noexcept { record_order(2u); },
+                                        RecordingFunctor{});
+    REQUIRE_FALSE(recorded_order);
+  }
+
+  REQUIRE(recorded_order == 321u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A dismissed multi-callback scope_guard does not execute any of its "
+          "callbacks.")
+{
+  reset();
+  auto lambda_count = 0u;
+
+  {
+    auto guard =
+      make_scope_guard(inc, [&lambda_count]() noexcept { incc(lambda_count); });
+    guard.dismiss();
+  }
+
+  REQUIRE_FALSE(count);
+  REQUIRE_FALSE(lambda_count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Individual callbacks of a multi-callback scope_guard can be "
+          "dismissed without affecting the others.")
+{
+  recorded_order = 0u;
+
+  {
+    auto guard = make_scope_guard([]() noexcept { record_order(1u); },
+                                  []() noexcept { record_order(2u); },
+                                  RecordingFunctor{});
+    guard.dismiss<1>();
+    guard.dismiss<1>(); // no further effect
+  }
+
+  REQUIRE(recorded_order == 31u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A multi-callback scope_guard executes its callbacks when leaving "
+          "scope due to an exception")
+{
+  reset();
+  fake_do();
+
+  try
+  {
+    const auto guard = make_scope_guard(fake_undo, inc);
+    throw "foobar";
+  }
+  catch(...)
+  {
+    REQUIRE_FALSE(is_fake_done);
+    REQUIRE(count == 1u);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When a multi-callback scope_guard is move-constructed, the "
+          "callbacks that were not dismissed are executed only once, by the "
+          "destination scope_guard")
+{
+  recorded_order = 0u;
+
+  {
+    auto source = make_scope_guard([]() noexcept { record_order(1u); },
+                                   []() noexcept { record_order(2u); });
+    source.dismiss<0>();
+    {
+      const auto dest = std::move(source);
+      REQUIRE_FALSE(recorded_order);
+    }
+    REQUIRE(recorded_order == 2u);
+  }
+
+  REQUIRE(recorded_order == 2u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A multi-callback scope_guard exposes the type of each callback and "
+          "uses a single activity mask")
+{
+  const auto lambda = []() noexcept { inc(); };
+  auto guard = make_scope_guard(inc, lambda, StatelessFunctor{});
+  using guard_type = decltype(guard);
+
+  static_assert(std::is_same<guard_type::callback_type<0>,
+                             decltype(inc)&>::value,
+                "unexpected callback type");
+  static_assert(std::is_same<guard_type::callback_type<1>,
+                             decltype(lambda)&>::value,
+                "unexpected callback type");
+  static_assert(std::is_same<guard_type::callback_type<2>,
+                             StatelessFunctor>::value,
+                "unexpected callback type");
+
+  static_assert(sizeof(make_scope_guard(StatelessFunctor{},
+                                        RecordingFunctor{})) == 1u,
+                "stateless callbacks take space in multi-callback scope_guard");
+  static_assert(sizeof(detail::mask_for_t<9>::type) == sizeof(unsigned short) &&
+                sizeof(detail::mask_for_t<32>::type) == sizeof(unsigned int),
+                "activity mask wider than needed");
+  static_assert(noexcept(guard.dismiss()) && noexcept(guard.dismiss<2>()),
+                "dismiss not noexcept");
+
+  guard.dismiss();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  template<typename T, typename U>
+  auto multi_sfinae_tester_impl(T&& t, U&& u, tag_prefered_overload&& /**/)
+  -> decltype(make_scope_guard(std::forward<T>(t), std::forward<U>(u)),
+              std::declval<void>())
+  {
+    make_scope_guard(std::forward<T>(t), std::forward<U>(u));
+  }
+
+  template<typename T, typename U>
+  void multi_sfinae_tester_impl(T&& /*ignored*/, U&& /*ignored*/,
+                                ... /* less specific, so 2nd choice */)
+  {
+    make_scope_guard(inc);
+  }
+
+  template<typename T, typename U>
+  void multi_sfinae_tester(T&& t, U&& u)
+  {
+    multi_sfinae_tester_impl(std::forward<T>(t), std::forward<U>(u),
+                             tag_prefered_overload{}); // see sfinae_tester
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When deducing a multi-callback make_scope_guard's callback types, a "
+          "substitution failure caused by any improper callback can be "
+          "recovered from without a compilation error")
+{
+  reset();
+
+  multi_sfinae_tester(noop, noop); // does not affect count
+  REQUIRE_FALSE(count);
+
+  multi_sfinae_tester(noop, 123);
+  REQUIRE(count == 1u);
+
+  multi_sfinae_tester(incc, noop);
+  REQUIRE(count == 2u);
+
+  multi_sfinae_tester(noop, []() noexcept { return true; });
+  REQUIRE(count == 3u);
+}
+
+/* --- guard_stack --- */
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A guard_stack executes each pushed callback exactly once, in "
+          "reverse order, when leaving scope.")
+{
+  recorded_order = 0u;
+
+  {
+    guard_stack<4> stack;
+    for(auto i = 1u; i <= 3u; ++i)
+      stack.push([i]() noexcept { record_order(i); });
+    REQUIRE(stack.size() == 3u);
+    REQUIRE_FALSE(recorded_order);
+  }
+
+  REQUIRE(recorded_order == 321u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A guard_stack accepts callbacks beyond its inline capacity and "
+          "still executes all of them in reverse order.")
+{
+  auto next_expected = 100u;
+  auto in_order = true;
+
+  {
+    guard_stack<2> stack;
+    for(auto i = 0u; i < 100u; ++i)
+      stack.push([i, &next_expected, &in_order]() noexcept
+                 { in_order = in_order && i == --next_expected; });
+    REQUIRE(stack.size() == 100u);
+  }
+
+  REQUIRE(next_expected == 0u);
+  REQUIRE(in_order);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A guard_stack accepts callbacks of different kinds.")
+{
+  reset();
+  auto lambda_count = 0u;
+  const auto lambda = [&lambda_count]() noexcept { incc(lambda_count); };
+
+  {
+    guard_stack<2> stack;
+    stack.push(inc);
+    stack.push(lambda);
+    stack.push(StatelessFunctor{});
+    stack.push(StatefulFunctor{lambda_count});
+  }
+
+  REQUIRE(count == 2u);
+  REQUIRE(lambda_count == 2u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Dismissing all the callbacks of a guard_stack prevents their "
+          "execution, but not that of callbacks pushed afterwards.")
+{
+  recorded_order = 0u;
+
+  {
+    guard_stack<2> stack;
+    for(auto i = 1u; i <= 5u; ++i)
+      stack.push([i]() noexcept { record_order(i); });
+    stack.dismiss_all();
+    stack.dismiss_all(); // no further effect
+
+    for(auto i = 6u; i <= 7u; ++i)
+      stack.push([i]() noexcept { record_order(i); });
+  }
+
+  REQUIRE(recorded_order == 76u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Committing a guard_stack is the same as dismissing all its "
+          "callbacks.")
+{
+  reset();
+
+  {
+    guard_stack<1> stack;
+    stack.push(inc);
+    stack.push(inc);
+    stack.commit();
+  }
+
+  REQUIRE_FALSE(count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A guard_stack destroys its callbacks, whether they were dismissed "
+          "or not.")
+{
+  const auto resource = std::make_shared<int>(0);
+
+  {
+    guard_stack<1> stack;
+    for(auto i = 0; i < 3; ++i)
+      stack.push([resource]() noexcept { ++*resource; });
+    stack.dismiss_all();
+    stack.push([resource]() noexcept { ++*resource; });
+    REQUIRE(resource.use_count() == 5);
+  }
+
+  REQUIRE(resource.use_count() == 1);
+  REQUIRE(*resource == 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A guard_stack executes its callbacks when leaving scope due to an "
+          "exception")
+{
+  reset();
+  fake_do();
+
+  try
+  {
+    guard_stack<1> stack;
+    stack.push(fake_undo);
+    stack.push(inc);
+    throw "foobar";
+  }
+  catch(...)
+  {
+    REQUIRE_FALSE(is_fake_done);
+    REQUIRE(count == 1u);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  auto fail_next_nothrow_new = false; // what guard_stack allocates chunks with
+} // namespace
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  if(fail_next_nothrow_new)
+  {
+    fail_next_nothrow_new = false;
+    return nullptr;
+  }
+
+  try
+  {
+    return ::operator new(size);
+  }
+  catch(const std::bad_alloc&)
+  {
+    return nullptr;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When a guard_stack cannot allocate room for a pushed callback, it "
+          "executes that callback before throwing std::bad_alloc.")
+{
+  reset();
+  fake_do();
+  auto threw = false;
+
+  {
+    guard_stack<1> stack;
+    stack.push(inc);
+
+    fail_next_nothrow_new = true;
+    try
+    {
+      stack.push(fake_undo);
+    }
+    catch(const std::bad_alloc&)
+    {
+      threw = true;
+      REQUIRE_FALSE(is_fake_done);
+      REQUIRE_FALSE(count);
+      REQUIRE(stack.size() == 1u);
+    }
+  }
+
+  REQUIRE(threw);
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  template<typename T>
+  auto stack_sfinae_tester_impl(T&& t, tag_prefered_overload&& /*ignored*/)
+  -> decltype(std::declval<guard_stack<1>&>().push(std::forward<T>(t)),
+              std::declval<void>())
+  {
+    guard_stack<1> stack;
+    stack.push(std::forward<T>(t));
+  }
+
+  template<typename T>
+  void stack_sfinae_tester_impl(T&& /*ignored*/,
+                                ... /* less specific, so 2nd choice */)
+  {
+    inc();
+  }
+
+  template<typename T>
+  void stack_sfinae_tester(T&& t)
+  {
+    stack_sfinae_tester_impl(std::forward<T>(t), tag_prefered_overload{});
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Pushing an improper callback into a guard_stack is a substitution "
+          "failure that can be recovered from without a compilation error")
+{
+  reset();
+
+  stack_sfinae_tester(noop);
+  REQUIRE_FALSE(count);
+
+  stack_sfinae_tester(123);
+  REQUIRE(count == 1u);
+
+  stack_sfinae_tester(incc);
+  REQUIRE(count == 2u);
+
+  stack_sfinae_tester([]() noexcept { return true; });
+  REQUIRE(count == 3u);
+}
+
+/* --- guard_vector --- */
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  // checks that it is called in countdown order (trivially copyable)
+  struct countdown_checker
+  {
+    countdown_checker(unsigned index, unsigned& next_expected,
+                      bool& in_order) noexcept
+      : m_index{index}
+      , m_next_expected{&next_expected}
+      , m_in_order{&in_order}
+    {}
+
+    void operator()() const noexcept
+    {
+      *m_in_order = *m_in_order && m_index == --*m_next_expected;
+    }
+
+    unsigned m_index;
+    unsigned* m_next_expected;
+    bool* m_in_order;
+  };
+
+  // same, but not trivially copyable (so moved, unless specialized otherwise)
+  struct moving_countdown_checker : countdown_checker
+  {
+    using countdown_checker::countdown_checker;
+
+    moving_countdown_checker(moving_countdown_checker&& other) noexcept
+      : countdown_checker{other}
+    {}
+  };
+
+  struct relocatable_countdown_checker : moving_countdown_checker
+  {
+    using moving_countdown_checker::moving_countdown_checker;
+  };
+
+  /* Pushes count checkers into a guard_vector, without reserving, and tells
+  whether they were all called back in reverse order when it was destroyed */
+  template<typename Checker>
+  bool guard_vector_counts_down(unsigned count)
+  {
+    auto next_expected = count;
+    auto in_order = true;
+
+    {
+      guard_vector<detail::scope_guard<Checker>> guards;
+      for(auto i = 0u; i < count; ++i)
+        guards.push_back(
+          make_scope_guard(Checker{i, next_expected, in_order}));
+      if(guards.size() != count || guards.capacity() < count ||
+         next_expected != count)
+        return false;
+    }
+
+    return next_expected == 0u && in_order;
+  }
+} // namespace
+
+namespace sg
+{
+  template<>
+  struct is_trivially_relocatable<relocatable_countdown_checker>
+    : public std::true_type
+  {}; // a client's promise
+} // namespace sg
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("scope_guards are trivially relocatable exactly when their callbacks "
+          "are")
+{
+  static_assert(is_trivially_relocatable<
+                  decltype(make_scope_guard(inc))>::value,
+                "reference callback considered not trivially relocatable");
+  static_assert(is_trivially_relocatable<
+                  detail::scope_guard<countdown_checker>>::value,
+                "trivially copyable callback considered not trivially "
+                "relocatable");
+  static_assert(is_trivially_relocatable<
+                  detail::scope_guard<relocatable_countdown_checker>>::value,
+                "client specialization ignored");
+  static_assert(!guard_vector<
+                  detail::scope_guard<moving_countdown_checker>>::
+                  relocates_bitwise || is_trivially_relocatable<
+                    moving_countdown_checker>::value,
+                "guard_vector relocates bitwise without the trait");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A guard_vector executes each guard's callback exactly once, in "
+          "reverse order, when leaving scope, also after growing.")
+{
+  REQUIRE(guard_vector_counts_down<countdown_checker>(3u));
+  REQUIRE(guard_vector_counts_down<countdown_checker>(1000u));
+  REQUIRE(guard_vector_counts_down<relocatable_countdown_checker>(1000u));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A guard_vector of guards that are not trivially relocatable moves "
+          "them on growth, without calling back")
+{
+  REQUIRE(guard_vector_counts_down<moving_countdown_checker>(3u));
+  REQUIRE(guard_vector_counts_down<moving_countdown_checker>(1000u));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A guard that is pushed into a guard_vector is left inactive")
+{
+  reset();
+
+  {
+    guard_vector<decltype(make_scope_guard(inc))> guards;
+    auto guard = make_scope_guard(inc);
+    guards.push_back(std::move(guard));
+    REQUIRE_FALSE(count);
+  }
+
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Reserving room in a guard_vector keeps its guards")
+{
+  reset();
+
+  {
+    guard_vector<decltype(make_scope_guard(inc))> guards;
+    guards.reserve(2u);
+    REQUIRE(guards.capacity() == 2u);
+
+    guards.push_back(make_scope_guard(inc));
+    guards.reserve(1u); // no effect
+    REQUIRE(guards.capacity() == 2u);
+
+    guards.reserve(100u);
+    REQUIRE(guards.capacity() == 100u);
+    REQUIRE(guards.size() == 1u);
+    REQUIRE_FALSE(count);
+  }
+
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Guards in a guard_vector can be dismissed individually or all at "
+          "once")
+{
+  reset();
+
+  {
+    guard_vector<decltype(make_scope_guard(inc))> guards;
+    for(auto i = 0; i < 20; ++i)
+      guards.push_back(make_scope_guard(inc));
+    guards[0].dismiss();
+  }
+  REQUIRE(count == 19u);
+
+  {
+    guard_vector<decltype(make_scope_guard(inc))> guards;
+    for(auto i = 0; i < 20; ++i)
+      guards.push_back(make_scope_guard(inc));
+    guards.commit();
+  }
+  REQUIRE(count == 19u);
+}
+
+/* --- any_scope_guard --- */
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("An any_scope_guard executes its callback exactly once when leaving "
+          "scope.")
+{
+  reset();
+
+  {
+    const auto guard = make_any_scope_guard(inc);
+    REQUIRE_FALSE(count);
+  }
+
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A dismissed any_scope_guard does not execute its callback at all "
+          "and releases it immediately.")
+{
+  reset();
+  const auto resource = std::make_shared<int>(0);
+
+  {
+    auto guard = make_any_scope_guard([resource]() noexcept { inc(); });
+    REQUIRE(resource.use_count() == 2);
+
+    guard.dismiss();
+    REQUIRE(resource.use_count() == 1);
+    guard.dismiss(); // no further effect
+  }
+
+  REQUIRE_FALSE(count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Callbacks of different types can be held by any_scope_guards of the "
+          "same type.")
+{
+  reset();
+  auto lambda_count = 0u;
+
+  {
+    std::vector<any_scope_guard<>> guards;
+    guards.push_back(make_any_scope_guard(inc));
+    guards.push_back(make_any_scope_guard(
+      [&lambda_count]() noexcept { incc(lambda_count); }));
+    guards.push_back(make_any_scope_guard(StatelessFunctor{}));
+    guards.push_back(make_any_scope_guard(StatefulFunctor{lambda_count}));
+    REQUIRE_FALSE(count);
+    REQUIRE_FALSE(lambda_count);
+  }
+
+  REQUIRE(count == 2u);
+  REQUIRE(lambda_count == 2u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When an any_scope_guard is move-constructed, the callback is "
+          "executed only once, by the destination guard.")
+{
+  const auto resource = std::make_shared<int>(0);
+
+  {
+    auto source = make_any_scope_guard([resource]() noexcept { ++*resource; });
+    {
+      const auto dest = std::move(source);
+      REQUIRE(resource.use_count() == 2); // relocated, not copied
+      REQUIRE_FALSE(*resource);
+    }
+    REQUIRE(*resource == 1);
+  }
+
+  REQUIRE(*resource == 1);
+  REQUIRE(resource.use_count() == 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When an any_scope_guard is move-assigned, the previous callback is "
+          "executed, if active, and the new one is taken over.")
+{
+  recorded_order = 0u;
+
+  {
+    auto guard = make_any_scope_guard([]() noexcept { record_order(1u); });
+    guard = make_any_scope_guard([]() noexcept { record_order(2u); });
+    REQUIRE(recorded_order == 1u);
+
+    guard.dismiss();
+    guard = make_any_scope_guard([]() noexcept { record_order(3u); });
+    REQUIRE(recorded_order == 1u);
+
+    auto other = make_any_scope_guard([]() noexcept { record_order(4u); });
+    other.dismiss();
+    guard = std::move(other); // executes 3, takes nothing
+    REQUIRE(recorded_order == 13u);
+  }
+
+  REQUIRE(recorded_order == 13u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Move-assigning an any_scope_guard to itself has no effect.")
+{
+  reset();
+
+  {
+    auto guard = make_any_scope_guard(inc);
+    auto& same = guard;
+    guard = std::move(same);
+    REQUIRE_FALSE(count);
+  }
+
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("An any_scope_guard with a custom buffer size holds larger "
+          "callbacks inline.")
+{
+  auto a = 0u, b = 0u, c = 0u, d = 0u, e = 0u;
+
+  {
+    const auto guard = make_any_scope_guard<8 * sizeof(void*)>(
+      [&a, &b, &c, &d, &e]() noexcept { ++a; ++b; ++c; ++d; ++e; });
+    static_assert(sizeof(guard) <= 8 * sizeof(void*) + alignof(max_align_t),
+                  "any_scope_guard larger than expected");
+  }
+
+  REQUIRE(a + b + c + d + e == 5u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("An any_scope_guard's operations are noexcept, even with callbacks "
+          "that are not.")
+{
+  auto guard = make_any_scope_guard(inc);
+  static_assert(noexcept(any_scope_guard<>{std::move(guard)}),
+                "any_scope_guard move constructor not noexcept");
+  static_assert(noexcept(guard = std::move(guard)),
+                "any_scope_guard move assignment not noexcept");
+  static_assert(noexcept(guard.dismiss()), "dismiss not noexcept");
+  static_assert(noexcept(guard.~any_scope_guard()), "dtor not noexcept");
+  guard.dismiss();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("An any_scope_guard executes its callback when leaving scope due to "
+          "an exception")
+{
+  fake_do();
+
+  try
+  {
+    const auto guard = make_any_scope_guard(fake_undo);
+    throw "foobar";
+  }
+  catch(...)
+  {
+    REQUIRE_FALSE(is_fake_done);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  template<typename T>
+  auto any_sfinae_tester_impl(T&& t, tag_prefered_overload&& /*ignored*/)
+  -> decltype(make_any_scope_guard(std::forward<T>(t)), std::declval<void>())
+  {
+    make_any_scope_guard(std::forward<T>(t));
+  }
+
+  template<typename T>
+  void any_sfinae_tester_impl(T&& /*ignored*/,
+                              ... /* less specific, so 2nd choice */)
+  {
+    make_any_scope_guard(inc);
+  }
+
+  template<typename T>
+  void any_sfinae_tester(T&& t)
+  {
+    any_sfinae_tester_impl(std::forward<T>(t), tag_prefered_overload{});
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When deducing make_any_scope_guard's callback type, a substitution "
+          "failure caused by an improper callback can be recovered from "
+          "without a compilation error")
+{
+  reset();
+
+  any_sfinae_tester(noop);
+  REQUIRE_FALSE(count);
+
+  any_sfinae_tester(123);
+  REQUIRE(count == 1u);
+
+  any_sfinae_tester(incc);
+  REQUIRE(count == 2u);
+
+  any_sfinae_tester([]() noexcept { return true; });
+  REQUIRE(count == 3u);
+}
+
+/* --- reusable_scope_guard --- */
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  struct digit_recorder
+  {
+    explicit digit_recorder(unsigned digit) noexcept : m_digit{digit} {}
+    void operator()() const noexcept { record_order(m_digit); }
+
+    unsigned m_digit;
+  };
+
+  template<on_replace Policy>
+  using recorder_slot = reusable_scope_guard<digit_recorder, Policy>;
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A reusable_scope_guard executes its callback exactly once when "
+          "leaving scope, unless dismissed, which releases the callback "
+          "immediately.")
+{
+  reset();
+  {
+    const auto guard = make_reusable_scope_guard(inc);
+    REQUIRE_FALSE(count);
+  }
+  REQUIRE(count == 1u);
+
+  const auto resource = std::make_shared<int>(0);
+  {
+    auto guard = make_reusable_scope_guard([resource]() noexcept { inc(); });
+    REQUIRE(resource.use_count() == 2);
+
+    guard.dismiss();
+    REQUIRE(resource.use_count() == 1);
+    guard.dismiss(); // no further effect
+  }
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A default-constructed reusable_scope_guard is inactive until it is "
+          "reset.")
+{
+  recorded_order = 0u;
+
+  {
+    recorder_slot<on_replace::fire> slot;
+    slot.dismiss(); // no effect
+  }
+  REQUIRE_FALSE(recorded_order);
+
+  {
+    recorder_slot<on_replace::fire> slot;
+    slot.reset(digit_recorder{1u});
+    REQUIRE_FALSE(recorded_order);
+  }
+  REQUIRE(recorded_order == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Resetting a reusable_scope_guard fires or discards the current "
+          "callback, per policy, and then takes the new one.")
+{
+  recorded_order = 0u;
+  {
+    auto guard = make_reusable_scope_guard(digit_recorder{1u});
+    guard.reset(digit_recorder{2u});
+    REQUIRE(recorded_order == 1u);
+    guard.dismiss();
+    guard.reset(digit_recorder{3u}); // nothing to fire
+    REQUIRE(recorded_order == 1u);
+  }
+  REQUIRE(recorded_order == 13u);
+
+  recorded_order = 0u;
+  {
+    auto guard =
+      make_reusable_scope_guard<on_replace::discard>(digit_recorder{1u});
+    guard.reset(digit_recorder{2u});
+    REQUIRE_FALSE(recorded_order);
+  }
+  REQUIRE(recorded_order == 2u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Move-assigning a reusable_scope_guard fires or discards the current "
+          "callback, per policy, and then takes over the other's callback, "
+          "leaving it inactive.")
+{
+  recorded_order = 0u;
+  {
+    auto guard = make_reusable_scope_guard(digit_recorder{1u});
+    auto other = make_reusable_scope_guard(digit_recorder{2u});
+    guard = std::move(other);
+    REQUIRE(recorded_order == 1u);
+
+    auto& self = guard;
+    guard = std::move(self); // no effect
+    REQUIRE(recorded_order == 1u);
+  }
+  REQUIRE(recorded_order == 12u);
+
+  recorded_order = 0u;
+  {
+    recorder_slot<on_replace::discard> guard;
+    guard = make_reusable_scope_guard<on_replace::discard>(digit_recorder{1u});
+    guard = make_reusable_scope_guard<on_replace::discard>(digit_recorder{2u});
+    REQUIRE_FALSE(recorded_order);
+
+    recorder_slot<on_replace::discard> inactive;
+    guard = std::move(inactive); // discards, takes nothing
+  }
+  REQUIRE_FALSE(recorded_order);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When a reusable_scope_guard is move-constructed, the callback is "
+          "executed only once, by the destination guard.")
+{
+  reset();
+
+  {
+    auto source = make_reusable_scope_guard(inc);
+    {
+      const auto dest = std::move(source);
+      REQUIRE_FALSE(count);
+    }
+    REQUIRE(count == 1u);
+  }
+
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("reusable_scope_guards can be kept in a fixed array of slots, which "
+          "is reused as a ring buffer.")
+{
+  recorded_order = 0u;
+
+  {
+    std::array<recorder_slot<on_replace::fire>, 3> ring;
+    for(auto i = 1u; i <= 5u; ++i)
+      ring[i % ring.size()].reset(digit_recorder{i}); // fires what was there
+    REQUIRE(recorded_order == 12u);
+  } // the array destroys its slots in reverse order
+
+  REQUIRE(recorded_order == 12543u);
+}
+
+/* --- atomic_scope_guard --- */
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("An atomic_scope_guard executes its callback exactly once when "
+          "leaving scope, unless dismissed.")
+{
+  reset();
+  {
+    const auto guard = make_atomic_scope_guard(inc);
+    REQUIRE_FALSE(count);
+  }
+  REQUIRE(count == 1u);
+
+  {
+    auto guard = make_atomic_scope_guard(inc);
+    guard.dismiss();
+    guard.dismiss(); // no effect
+  }
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Only the first try_dismiss on an atomic_scope_guard reports that it "
+          "dismissed the guard.")
+{
+  reset();
+  {
+    auto guard = make_atomic_scope_guard(inc);
+    REQUIRE(guard.try_dismiss());
+    REQUIRE_FALSE(guard.try_dismiss());
+  }
+  REQUIRE_FALSE(count);
+
+  {
+    auto guard = make_atomic_scope_guard(inc);
+    guard.dismiss();
+    REQUIRE_FALSE(guard.try_dismiss());
+  }
+  REQUIRE_FALSE(count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When an atomic_scope_guard is move-constructed, the callback is "
+          "executed only once, by the destination guard, unless the source "
+          "was dismissed.")
+{
+  reset();
+  {
+    auto source = make_atomic_scope_guard(inc);
+    {
+      auto dest = std::move(source);
+      REQUIRE_FALSE(source.try_dismiss()); // the source no longer has it
+    }
+    REQUIRE(count == 1u);
+  }
+  REQUIRE(count == 1u);
+
+  {
+    auto source = make_atomic_scope_guard(inc);
+    source.dismiss();
+    const auto dest = std::move(source);
+  }
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("An atomic_scope_guard accepts the same callbacks as a scope_guard, "
+          "including references.")
+{
+  reset();
+  {
+    StatefulFunctor functor{count};
+    const auto ref_guard = make_atomic_scope_guard(functor);
+    const auto fun_guard = make_atomic_scope_guard(inc);
+    const auto lambda_guard = make_atomic_scope_guard([]() noexcept { inc(); });
+  }
+  REQUIRE(count == 3u);
+}
+
+/* --- cold_scope_guard --- */
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A cold_scope_guard executes its callback exactly once when leaving "
+          "scope, unless dismissed.")
+{
+  reset();
+  {
+    const auto guard = make_cold_scope_guard(inc);
+    REQUIRE_FALSE(count);
+  }
+  REQUIRE(count == 1u);
+
+  {
+    auto guard = make_cold_scope_guard([]() noexcept { inc(); });
+    guard.dismiss();
+  }
+  REQUIRE(count == 1u);
+
+  {
+    StatefulFunctor functor{count};
+    const auto guard = make_cold_scope_guard(functor); // by reference
+  }
+  REQUIRE(count == 2u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A cold_scope_guard executes its callback when leaving scope due to "
+          "an exception.")
+{
+  fake_do();
+
+  try
+  {
+    const auto guard = make_cold_scope_guard(fake_undo);
+    throw "foobar";
+  }
+  catch(...)
+  {
+    REQUIRE_FALSE(is_fake_done);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When a cold_scope_guard is move-constructed, the callback is "
+          "executed only once, by the destination guard.")
+{
+  reset();
+  {
+    auto source = make_cold_scope_guard(inc);
+    {
+      const auto dest = std::move(source);
+    }
+    REQUIRE(count == 1u);
+  }
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A cold_scope_guard is laid out as a scope_guard.")
+{
+  auto i = 0u;
+  static_assert(sizeof(make_cold_scope_guard(StatefulFunctor{i})) ==
+                sizeof(make_scope_guard(StatefulFunctor{i})),
+                "unexpected size of cold_scope_guard");
+  static_assert(noexcept(make_cold_scope_guard(inc).dismiss()),
+                "dismiss not noexcept");
+}
+
+/* --- latency guard --- */
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  // a tick source that the tests control
+  struct fake_ticks
+  {
+    static std::uint64_t now() noexcept { return ticks; }
+    static std::uint64_t ticks;
+  };
+  std::uint64_t fake_ticks::ticks = 0u;
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("The buckets of a latency_histogram cover all tick counts, in "
+          "order, and each is at most 12.5% wider than its lower bound.")
+{
+  using h = latency_histogram;
+  REQUIRE(h::bucket_lower_bound(0) == 0u);
+  REQUIRE(h::bucket_upper_bound(h::bucket_count - 1) == UINT64_MAX);
+
+  for(auto i = std::size_t{1}; i < h::bucket_count; ++i)
+  {
+    const auto lower = h::bucket_lower_bound(i);
+    const auto upper = h::bucket_upper_bound(i);
+    REQUIRE(lower == h::bucket_upper_bound(i - 1) + 1u);
+    REQUIRE(upper - lower <= lower / 8u);
+    REQUIRE(h::bucket_index(lower) == i);
+    REQUIRE(h::bucket_index(upper) == i);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A latency_histogram counts recorded values and reports the bucket "
+          "holding each quantile.")
+{
+  latency_histogram histogram;
+  REQUIRE(histogram.quantile(0.5) == 0u);
+
+  for(auto ticks = 1u; ticks <= 100u; ++ticks)
+    histogram.record(ticks);
+  histogram.record(1000000u);
+
+  REQUIRE(histogram.count() == 101u);
+  REQUIRE(histogram.bucket(latency_histogram::bucket_index(7u)) == 1u);
+  REQUIRE(histogram.quantile(0.0) == 1u);
+  REQUIRE(histogram.quantile(0.5) ==
+          latency_histogram::bucket_upper_bound(
+            latency_histogram::bucket_index(51u)));
+  REQUIRE(histogram.quantile(1.0) >= 1000000u);
+  REQUIRE(histogram.quantile(1.0) <= 1125000u);
+
+  latency_histogram other;
+  other.record(7u);
+  other.merge(histogram);
+  REQUIRE(other.count() == 102u);
+  REQUIRE(other.bucket(latency_histogram::bucket_index(7u)) == 2u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A latency guard records the ticks elapsed in its scope at its "
+          "site, unless dismissed.")
+{
+  static latency_site site{"catch/latency guard"};
+  {
+    fake_ticks::ticks = 100u;
+    const auto guard = make_latency_guard<fake_ticks>(site);
+    fake_ticks::ticks = 142u;
+  }
+  {
+    auto guard = make_latency_guard<fake_ticks>(site);
+    fake_ticks::ticks = 1000u;
+    guard.dismiss(); // e.g. a failed request, kept out of the figures
+  }
+  {
+    auto source = make_latency_guard<fake_ticks>(site);
+    const auto dest = std::move(source); // recorded once
+    fake_ticks::ticks = 1005u;
+  }
+
+  const auto histogram = site.histogram();
+  REQUIRE(histogram.count() == 2u);
+  REQUIRE(histogram.bucket(latency_histogram::bucket_index(42u)) == 1u);
+  REQUIRE(histogram.bucket(latency_histogram::bucket_index(5u)) == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Latency sites get increasing ids, and sites without records are "
+          "left out of dumps.")
+{
+  static latency_site recorded{"catch/recorded"};
+  static latency_site idle{"catch/idle"};
+  REQUIRE(idle.id() == recorded.id() + 1u);
+  REQUIRE(std::string{idle.name()} == "catch/idle");
+
+  {
+    fake_ticks::ticks = 0u;
+    const auto guard = make_latency_guard<fake_ticks>(recorded);
+    fake_ticks::ticks = 3u;
+  }
+
+  std::ostringstream out;
+  dump_latencies(out);
+  REQUIRE(out.str().find("catch/recorded: count 1, p50 3, p90 3, p99 3, "
+                         "max 3 ticks\n") != std::string::npos);
+  REQUIRE(out.str().find("catch/idle") == std::string::npos);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Latency guards are plain scope guards, with steady_clock ticks by "
+          "default.")
+{
+  static latency_site site{"catch/steady"};
+  {
+    const auto guard = make_latency_guard(site);
+    static_assert(std::is_same<decltype(guard),
+                               const decltype(make_scope_guard(
+                                 std::declval<detail::latency_recorder<
+                                   steady_ticks>>()))>::value,
+                  "unexpected latency guard type");
+    static_assert(noexcept(make_latency_guard(site)), "maker not noexcept");
+  }
+  REQUIRE(site.histogram().count() == 1u);
+}
+
+/* --- trace zones --- */
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  std::size_t occurrences(const std::string& str, const std::string& sub)
+  {
+    auto n = std::size_t{0};
+    for(auto pos = str.find(sub); pos != std::string::npos;
+        pos = str.find(sub, pos + sub.size()))
+      ++n;
+    return n;
+  }
+
+  std::string flushed_trace()
+  {
+    std::ostringstream out;
+    flush_trace(out);
+    return out.str();
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Trace zones write begin and end events, in order, which a flush "
+          "drains as Chrome trace-event JSON.")
+{
+  flushed_trace(); // discard earlier events
+  {
+    SG_TRACE_ZONE("outer");
+    {
+      SG_TRACE_ZONE("inner");
+    }
+  }
+
+  const auto trace = flushed_trace();
+  const auto outer_begin = trace.find("{\"name\": \"outer\", \"ph\": \"B\"");
+  const auto inner_begin = trace.find("{\"name\": \"inner\", \"ph\": \"B\"");
+  const auto inner_end = trace.find("{\"name\": \"inner\", \"ph\": \"E\"");
+  const auto outer_end = trace.find("{\"name\": \"outer\", \"ph\": \"E\"");
+  REQUIRE(trace.find("{\"traceEvents\": [") == 0u);
+  REQUIRE(outer_begin < inner_begin);
+  REQUIRE(inner_begin < inner_end);
+  REQUIRE(inner_end < outer_end);
+  REQUIRE(outer_end != std::string::npos);
+  REQUIRE(occurrences(trace, "\"pid\": 1, \"tid\": ") == 4u);
+
+  REQUIRE(occurrences(flushed_trace(), "\"ph\"") == 0u); // drained
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Several trace zones can be expanded in the same line, and end in "
+          "reverse order.")
+{
+  flushed_trace();
+  {
+    SG_TRACE_ZONE("first"); SG_TRACE_ZONE("second");
+  }
+
+  const auto trace = flushed_trace();
+  const auto first_end = trace.find("{\"name\": \"first\", \"ph\": \"E\"");
+  const auto second_end = trace.find("{\"name\": \"second\", \"ph\": \"E\"");
+  REQUIRE(trace.find("{\"name\": \"first\", \"ph\": \"B\"") <
+          trace.find("{\"name\": \"second\", \"ph\": \"B\""));
+  REQUIRE(second_end < first_end);
+  REQUIRE(first_end != std::string::npos);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When a thread's trace buffer wraps around, the oldest events are "
+          "lost, and end events whose begin events were lost are left out.")
+{
+  flushed_trace();
+  {
+    SG_TRACE_ZONE("wrapped");
+    for(auto i = 0; i < SG_TRACE_BUFFER_EVENTS; ++i)
+    {
+      SG_TRACE_ZONE("step");
+    }
+  } // 2 + 2 * SG_TRACE_BUFFER_EVENTS events, of which the newest are kept
+
+  const auto trace = flushed_trace();
+  REQUIRE(occurrences(trace, "\"wrapped\"") == 0u);
+  REQUIRE(occurrences(trace, "\"ph\": \"B\"") ==
+          (SG_TRACE_BUFFER_EVENTS - 2) / 2);
+  REQUIRE(occurrences(trace, "\"ph\": \"E\"") ==
+          (SG_TRACE_BUFFER_EVENTS - 2) / 2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Trace zone names are escaped in JSON, and zones are plain scope "
+          "guards.")
+{
+  flushed_trace();
+  {
+    SG_TRACE_ZONE("a \"quoted\"\\name\n");
+    static_assert(std::is_same<decltype(detail::begin_trace_zone("")),
+                               decltype(make_scope_guard(
+                                 std::declval<detail::trace_zone_end>()))
+                              >::value,
+                  "unexpected trace zone type");
+  }
+
+  REQUIRE(occurrences(flushed_trace(),
+                      "\"a \\\"quoted\\\"\\\\name\\u000a\"") == 2u);
+}
+
+/* --- undo_buffer --- */
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("An undo_buffer restores recorded bytes when leaving scope.")
+{
+  int values[] = {1, 2, 3, 4};
+  auto flag = true;
+
+  {
+    undo_buffer undo;
+    REQUIRE(undo.empty());
+
+    undo.record(values, sizeof(values));
+    undo.record(flag);
+    REQUIRE_FALSE(undo.empty());
+
+    values[0] = values[3] = 42;
+    flag = false;
+  }
+
+  REQUIRE(values[0] == 1);
+  REQUIRE(values[3] == 4);
+  REQUIRE(flag);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("An undo_buffer restores overlapping records in reverse order, "
+          "leaving the oldest bytes in place.")
+{
+  auto value = 1;
+
+  {
+    undo_buffer undo;
+    for(auto i = 2; i < 100; ++i)
+    {
+      undo.record(value);
+      value = i;
+    }
+  }
+
+  REQUIRE(value == 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A dismissed undo_buffer restores nothing that was recorded before "
+          "dismissal.")
+{
+  auto a = 'a', b = 'b';
+
+  {
+    undo_buffer undo;
+    undo.record(a);
+    a = 'x';
+    undo.dismiss();
+    REQUIRE(undo.empty());
+
+    undo.record(b);
+    b = 'y';
+  }
+
+  REQUIRE(a == 'x');
+  REQUIRE(b == 'b');
+
+  {
+    undo_buffer undo;
+    undo.record(a);
+    a = 'z';
+    undo.commit();
+  }
+
+  REQUIRE(a == 'z');
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("An undo_buffer restores an unaligned record of odd length and "
+          "accepts empty records.")
+{
+  char text[] = "abcdefghijklmnop";
+
+  {
+    undo_buffer undo;
+    undo.record(nullptr, 0u);
+    undo.record(text + 3, 7u);
+    undo.record(text, 0u);
+    std::memset(text, '-', sizeof(text) - 1);
+  }
+
+  REQUIRE(std::string{text} == "---defghij------");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("An undo_buffer restores contiguous records, which it merges, as "
+          "well as interleaved records.")
+{
+  char text[] = "abcdefgh";
+
+  {
+    undo_buffer undo;
+    for(auto i = 0u; i < 5u; ++i) // contiguous, so merged
+    {
+      undo.record(text[i]);
+      text[i] = '-';
+    }
+    undo.record(text[2]); // not contiguous with text[4]
+    text[2] = '+';
+    undo.record(text, 3u); // not contiguous with text[2]
+    text[0] = '*';
+    undo.record(text + 3, 5u); // contiguous with text + 3
+    text[7] = '*';
+    REQUIRE(std::string{text} == "*-+--fg*");
+  }
+
+  REQUIRE(std::string{text} == "abcdefgh");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("An undo_buffer keeps its records when growing its arena.")
+{
+  std::vector<std::uint64_t> values(10000);
+  for(auto i = 0u; i < values.size(); ++i)
+    values[i] = i;
+
+  {
+    undo_buffer undo;
+    undo.reserve(64u);
+    for(auto i = values.size(); i-- > 0;) // backwards, to prevent merging
+    {
+      undo.record(values[i]);
+      values[i] = 0u;
+    }
+  }
+
+  auto restored = 0u;
+  for(auto i = 0u; i < values.size(); ++i)
+    restored += values[i] == i;
+  REQUIRE(restored == values.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("An undo_buffer restores recorded bytes when leaving scope due to "
+          "an exception")
+{
+  auto value = 7;
+
+  try
+  {
+    undo_buffer undo;
+    undo.record(value);
+    value = 8;
+    throw "foobar";
+  }
+  catch(...)
+  {
+    REQUIRE(value == 7);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("An undo_buffer's destructor and dismiss are noexcept.")
+{
+  undo_buffer undo;
+  static_assert(noexcept(undo.~undo_buffer()), "dtor not noexcept");
+  static_assert(noexcept(undo.dismiss()), "dismiss not noexcept");
+  static_assert(noexcept(undo.commit()), "commit not noexcept");
+  static_assert(!std::is_copy_constructible<undo_buffer>::value &&
+                !std::is_move_constructible<undo_buffer>::value,
+                "undo_buffer should not be copyable or movable");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Rolling an undo_buffer back to a savepoint restores only what was "
+          "recorded after the savepoint was opened.")
+{
+  int values[] = {0, 0, 0};
+
+  undo_buffer undo;
+  undo.record(values[0]);
+  values[0] = 1;
+
+  const auto point = undo.open_savepoint();
+  undo.record(values[1]); // contiguous, but not merged across the savepoint
+  values[1] = 1;
+  undo.record(values[0]);
+  values[0] = 2;
+
+  undo.rollback_to(point);
+  REQUIRE(values[0] == 1);
+  REQUIRE(values[1] == 0);
+  REQUIRE_FALSE(undo.empty());
+
+  undo.record(values[2]);
+  values[2] = 1;
+  undo.rollback_to(point); // still valid
+  REQUIRE(values[2] == 0);
+  REQUIRE(values[0] == 1);
+
+  undo.rollback();
+  REQUIRE(values[0] == 0);
+  REQUIRE(undo.empty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Nested undo_scopes roll back their own records, unless committed, "
+          "in which case records are left to the enclosing scope.")
+{
+  auto lvl0 = 0, lvl1 = 0, lvl2a = 0, lvl2b = 0, lvl3 = 0;
+
+  {
+    undo_buffer undo;
+    undo.record(lvl0);
+    lvl0 = 1;
+
+    {
+      undo_scope scope1{undo};
+      undo.record(lvl1);
+      lvl1 = 1;
+
+      {
+        undo_scope scope2a{undo};
+        undo.record(lvl2a);
+        lvl2a = 1;
+
+        {
+          undo_scope scope3{undo};
+          undo.record(lvl3);
+          lvl3 = 1;
+          scope3.commit(); // merged into scope2a
+        }
+
+        REQUIRE(lvl3 == 1);
+      } // rolls back lvl2a and lvl3
+
+      REQUIRE_FALSE(lvl2a);
+      REQUIRE_FALSE(lvl3);
+      REQUIRE(lvl1 == 1);
+
+      {
+        undo_scope scope2b{undo};
+        undo.record(lvl2b);
+        lvl2b = 1;
+        scope2b.dismiss(); // merged into scope1
+      }
+
+      REQUIRE(lvl2b == 1);
+      scope1.commit(); // merged into the whole buffer
+    }
+
+    REQUIRE(lvl0 == 1);
+    REQUIRE(lvl1 == 1);
+    REQUIRE(lvl2b == 1);
+  } // rolls back everything still recorded
+
+  REQUIRE_FALSE(lvl0);
+  REQUIRE_FALSE(lvl1);
+  REQUIRE_FALSE(lvl2b);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("An undo_scope rolls back when leaving scope due to an exception, "
+          "while the enclosing undo_buffer survives")
+{
+  auto outer = 0, inner = 0;
+
+  undo_buffer undo;
+  undo.record(outer);
+  outer = 1;
+
+  try
+  {
+    undo_scope scope{undo};
+    undo.record(inner);
+    inner = 1;
+    throw "foobar";
+  }
+  catch(...)
+  {
+    REQUIRE_FALSE(inner);
+    REQUIRE(outer == 1);
+  }
+
+  static_assert(noexcept(undo.open_savepoint()) &&
+                noexcept(undo.rollback_to(undo_buffer::savepoint{})),
+                "savepoint operations not noexcept");
+  undo.commit();
+}
+
+/* --- scope_fail and scope_success --- */
+
+#ifdef SG_HAS_UNCAUGHT_EXCEPTIONS
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A scope_fail guard executes its callback only when leaving scope "
+          "due to an exception.")
+{
+  reset();
+
+  {
+    const auto guard = make_scope_fail(inc);
+  }
+
+  REQUIRE_FALSE(count);
+
+  try
+  {
+    const auto guard = make_scope_fail(inc);
+    throw "foobar";
+  }
+  catch(...)
+  {
+    REQUIRE(count == 1u);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A scope_success guard executes its callback only when leaving "
+          "scope normally.")
+{
+  reset();
+
+  {
+    const auto guard = make_scope_success(inc);
+  }
+
+  REQUIRE(count == 1u);
+
+  try
+  {
+    const auto guard = make_scope_success(inc);
+    throw "foobar";
+  }
+  catch(...)
+  {
+    REQUIRE(count == 1u);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  struct guarding_on_unwind
+  {
+    ~guarding_on_unwind()
+    {
+      { // an exception is in flight, but this scope is left normally
+        const auto fail_guard = make_scope_fail(inc);
+        const auto success_guard = make_scope_success([]() noexcept {
+          record_order(1u);
+        });
+      }
+    }
+  };
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("scope_fail and scope_success guards created while unwinding "
+          "distinguish how their own scope is left.")
+{
+  reset();
+  recorded_order = 0u;
+
+  try
+  {
+    guarding_on_unwind g;
+    throw "foobar";
+  }
+  catch(...)
+  {
+    const auto fail_guard = make_scope_fail(inc); // handled, so not failing
+    const auto success_guard = make_scope_success([]() noexcept {
+      record_order(2u);
+    });
+  }
+
+  REQUIRE_FALSE(count);
+  REQUIRE(recorded_order == 12u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A scope_fail guard replaces dismissing by hand on the success "
+          "path.")
+{
+  fake_do();
+
+  {
+    const auto guard = make_scope_fail(fake_undo);
+  }
+
+  REQUIRE(is_fake_done);
+
+  try
+  {
+    const auto guard = make_scope_fail(fake_undo);
+    throw "foobar";
+  }
+  catch(...)
+  {
+    REQUIRE_FALSE(is_fake_done);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  template<typename T>
+  auto fail_sfinae_tester_impl(T&& t, tag_prefered_overload&& /*ignored*/)
+  -> decltype(make_scope_fail(std::forward<T>(t)),
+              make_scope_success(std::forward<T>(t)),
+              std::declval<void>())
+  {
+    make_scope_fail(std::forward<T>(t));
+  }
+
+  template<typename T>
+  void fail_sfinae_tester_impl(T&& /*ignored*/,
+                               ... /* less specific, so 2nd choice */)
+  {
+    inc();
+  }
+
+  template<typename T>
+  void fail_sfinae_tester(T&& t)
+  {
+    fail_sfinae_tester_impl(std::forward<T>(t), tag_prefered_overload{});
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When deducing make_scope_fail's and make_scope_success's callback "
+          "type, a substitution failure caused by an improper callback can "
+          "be recovered from without a compilation error")
+{
+  reset();
+
+  fail_sfinae_tester(noop);
+  REQUIRE_FALSE(count);
+
+  fail_sfinae_tester(123);
+  REQUIRE(count == 1u);
+
+  fail_sfinae_tester(incc);
+  REQUIRE(count == 2u);
+}
+#endif
+
+/* --- commit_token --- */
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Guards sharing a commit token execute their callbacks when leaving "
+          "scope, unless the token was committed.")
+{
+  reset();
+
+  {
+    commit_token token;
+    std::vector<decltype(make_token_guard(token, inc))> guards;
+    for(auto i = 0; i < 100; ++i)
+      guards.push_back(make_token_guard(token, inc));
+    REQUIRE_FALSE(count);
+  }
+
+  REQUIRE(count == 100u);
+
+  {
+    commit_token token;
+    std::vector<decltype(make_token_guard(token, inc))> guards;
+    for(auto i = 0; i < 100; ++i)
+      guards.push_back(make_token_guard(token, inc));
+    REQUIRE_FALSE(token.is_committed());
+
+    token.commit(); // a single store
+    REQUIRE(token.is_committed());
+  }
+
+  REQUIRE(count == 100u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A guard sharing a commit token can still be dismissed on its own.")
+{
+  reset();
+  auto other_count = 0u;
+
+  {
+    commit_token token;
+    auto guard = make_token_guard(token, inc);
+    const auto other_guard = make_token_guard(
+      token, [&other_count]() noexcept { incc(other_count); });
+
+    guard.dismiss();
+    guard.dismiss(); // no further effect
+  }
+
+  REQUIRE_FALSE(count);
+  REQUIRE(other_count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When a guard sharing a commit token is moved, only the destination "
+          "executes the callback.")
+{
+  reset();
+
+  {
+    commit_token token;
+    auto guard = make_token_guard(token, inc);
+    {
+      const auto dest = std::move(guard);
+    }
+    REQUIRE(count == 1u);
+  }
+
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A guard sharing a commit token executes its callback when leaving "
+          "scope due to an exception")
+{
+  fake_do();
+  commit_token token;
+
+  try
+  {
+    const auto guard = make_token_guard(token, fake_undo);
+    throw "foobar";
+    token.commit(); // never reached
+  }
+  catch(...)
+  {
+    REQUIRE_FALSE(is_fake_done);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A guard sharing a commit token takes a pointer plus its callback, "
+          "and its operations are noexcept.")
+{
+  auto i = 0u;
+  commit_token token;
+  auto guard = make_token_guard(token, StatefulFunctor{i});
+  static_assert(sizeof(guard) == sizeof(void*) + sizeof(StatefulFunctor),
+                "unexpected size of token guard");
+  static_assert(sizeof(make_token_guard(token, StatelessFunctor{})) ==
+                sizeof(void*), "unexpected size of stateless token guard");
+  static_assert(noexcept(guard.dismiss()), "dismiss not noexcept");
+  static_assert(noexcept(token.commit()), "commit not noexcept");
+  static_assert(noexcept(guard.~token_scope_guard()), "dtor not noexcept");
+  static_assert(!std::is_copy_constructible<commit_token>::value &&
+                !std::is_move_constructible<commit_token>::value,
+                "commit_token should not be copyable or movable");
+  token.commit();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  template<typename T>
+  auto token_sfinae_tester_impl(T&& t, tag_prefered_overload&& /*ignored*/)
+  -> decltype(make_token_guard(std::declval<commit_token&>(),
+                               std::forward<T>(t)),
+              std::declval<void>())
+  {
+    commit_token token;
+    make_token_guard(token, std::forward<T>(t));
+  }
+
+  template<typename T>
+  void token_sfinae_tester_impl(T&& /*ignored*/,
+                                ... /* less specific, so 2nd choice */)
+  {
+    inc();
+  }
+
+  template<typename T>
+  void token_sfinae_tester(T&& t)
+  {
+    token_sfinae_tester_impl(std::forward<T>(t), tag_prefered_overload{});
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When deducing make_token_guard's callback type, a substitution "
+          "failure caused by an improper callback can be recovered from "
+          "without a compilation error")
+{
+  reset();
+
+  token_sfinae_tester(noop);
+  REQUIRE_FALSE(count);
+
+  token_sfinae_tester(123);
+  REQUIRE(count == 1u);
+
+  token_sfinae_tester(incc);
+  REQUIRE(count == 2u);
+}
+
+/* --- status guard --- */
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A status guard executes its callback when leaving scope with an "
+          "error in the status it observes, unless dismissed.")
+{
+  reset();
+
+  {
+    std::error_code ec;
+    const auto guard = make_status_guard(ec, inc);
+  }
+  REQUIRE_FALSE(count);
+
+  {
+    std::error_code ec;
+    const auto guard = make_status_guard(ec, inc);
+    ec = std::make_error_code(std::errc::invalid_argument);
+  }
+  REQUIRE(count == 1u);
+
+  {
+    auto rc = -1;
+    auto guard = make_status_guard(rc, inc);
+    guard.dismiss();
+    guard.dismiss(); // no further effect
+  }
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A status guard only considers its status, not exceptions.")
+{
+  fake_do();
+  auto rc = 0;
+
+  try
+  {
+    const auto guard = make_status_guard(rc, fake_undo);
+    throw "foobar";
+  }
+  catch(...)
+  {
+    REQUIRE(is_fake_done); // not undone: no error in rc
+  }
+
+  try
+  {
+    const auto guard = make_status_guard(rc, fake_undo);
+    rc = 1;
+    throw "foobar";
+  }
+  catch(...)
+  {
+    REQUIRE_FALSE(is_fake_done);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When a status guard is moved, only the destination executes the "
+          "callback.")
+{
+  reset();
+
+  {
+    auto rc = 1;
+    auto guard = make_status_guard(rc, inc);
+    {
+      const auto dest = std::move(guard);
+    }
+    REQUIRE(count == 1u);
+  }
+
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A status guard takes a pointer plus its callback, and its "
+          "operations are noexcept.")
+{
+  auto i = 0u;
+  const std::error_code ec;
+  auto guard = make_status_guard(ec, StatefulFunctor{i});
+  static_assert(sizeof(guard) == sizeof(void*) + sizeof(StatefulFunctor),
+                "unexpected size of status guard");
+  static_assert(sizeof(make_status_guard(ec, StatelessFunctor{})) ==
+                sizeof(void*), "unexpected size of stateless status guard");
+  static_assert(noexcept(guard.dismiss()), "dismiss not noexcept");
+  static_assert(noexcept(guard.~status_scope_guard()), "dtor not noexcept");
+}
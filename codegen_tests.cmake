@@ -0,0 +1,102 @@
+# Compiles codegen_tests.cpp to assembly and confirms that each function named
+# <name>_guarded costs the same as the corresponding <name>_manual: either they
+# have the same instructions, or they make the same calls (in the same order)
+# and their instruction counts differ by no more than a tolerance (so that the
+# compiler is free to lay out branches differently).
+#
+# Meant to be run in script mode (cmake -P), with the following definitions:
+#   COMPILER - the C++ compiler
+#   STANDARD - the C++ standard number (e.g. 11 or 17)
+#   SOURCE   - the file to compile
+#   OUTPUT   - where to write the assembly
+#   FLAGS    - (optional) additional compiler flags, as a list
+#   TOLERANCE - (optional) the accepted difference in instruction count, 0 by
+#               default
+
+if(NOT DEFINED TOLERANCE)
+  set(TOLERANCE 0)
+endif()
+
+execute_process(COMMAND ${COMPILER} -std=c++${STANDARD} -O2 -S ${FLAGS}
+                        -o ${OUTPUT} ${SOURCE}
+                RESULT_VARIABLE compile_result
+                ERROR_VARIABLE compile_error)
+if(NOT compile_result EQUAL 0)
+  message(FATAL_ERROR "Could not compile ${SOURCE}:\n${compile_error}")
+endif()
+
+file(STRINGS ${OUTPUT} asm_lines)
+
+# gather the (normalized) instructions of every function in the assembly
+set(current_function "")
+set(functions "")
+foreach(line IN LISTS asm_lines)
+  if(line MATCHES "^_?([A-Za-z_][A-Za-z0-9_]*):")
+    set(current_function ${CMAKE_MATCH_1})
+    list(APPEND functions ${current_function})
+    set(instructions_${current_function} "")
+    set(calls_${current_function} "")
+  elseif(line MATCHES "^[ \t]*\\.cfi_endproc")
+    set(current_function "")
+  elseif(current_function AND line MATCHES "^[ \t]+([^.#/ \t][^#]*)")
+    string(STRIP "${CMAKE_MATCH_1}" instruction)
+    string(REGEX REPLACE "[ \t]+" " " instruction "${instruction}")
+    string(REGEX REPLACE "\\.?L[A-Za-z]*[0-9]+" "<label>" instruction
+           "${instruction}")
+    list(APPEND instructions_${current_function} "${instruction}")
+
+    # calls, including tail calls, to named or indirect targets
+    if(instruction MATCHES "^(callq?|jmpq?|bl|b|br|blr) ([^<]+)$")
+      set(target ${CMAKE_MATCH_2})
+      if(target MATCHES "^\\*|^%|^x[0-9]+$") # e.g. *%rax, or x0 in aarch64
+        set(target "<indirect>")
+      endif()
+      string(REGEX REPLACE "@PLT$" "" target "${target}")
+      list(APPEND calls_${current_function} "${target}")
+    endif()
+  endif()
+endforeach()
+
+# compare pairs
+set(compared 0)
+set(tolerated "")
+set(failures "")
+foreach(function IN LISTS functions)
+  if(function MATCHES "^(.*)_guarded$")
+    set(manual ${CMAKE_MATCH_1}_manual)
+    if(NOT DEFINED instructions_${manual})
+      message(FATAL_ERROR "No ${manual} counterpart for ${function}")
+    endif()
+
+    math(EXPR compared "${compared} + 1")
+    list(LENGTH instructions_${function} guarded_count)
+    list(LENGTH instructions_${manual} manual_count)
+    math(EXPR difference "${guarded_count} - ${manual_count}")
+    if(difference LESS 0)
+      math(EXPR difference "-${difference}")
+    endif()
+
+    if("${instructions_${function}}" STREQUAL "${instructions_${manual}}")
+      # identical
+    elseif("${calls_${function}}" STREQUAL "${calls_${manual}}" AND
+           NOT difference GREATER TOLERANCE)
+      list(APPEND tolerated "${function} (${guarded_count} vs ${manual_count})")
+    else()
+      string(REPLACE ";" "\n    " guarded_str "${instructions_${function}}")
+      string(REPLACE ";" "\n    " manual_str "${instructions_${manual}}")
+      string(APPEND failures "\n${function}:\n    ${guarded_str}\n"
+                             "${manual}:\n    ${manual_str}\n")
+    endif()
+  endif()
+endforeach()
+
+if(compared EQUAL 0)
+  message(FATAL_ERROR "No function pairs found in ${OUTPUT}")
+elseif(failures)
+  message(FATAL_ERROR "Guarded and manual code differ:${failures}")
+endif()
+
+message(STATUS "${compared} function pairs compared")
+foreach(pair IN LISTS tolerated)
+  message(STATUS "Same calls, with a tolerable difference in layout: ${pair}")
+endforeach()
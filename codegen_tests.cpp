@@ -0,0 +1,205 @@
+/*
+ *  Created on: 15/10/2026
+ *      Author: ricab
+ *
+ * Pairs of functions that are compiled to assembly, with optimizations, and
+ * compared by codegen_tests.cmake. Each pair consists of a function suffixed
+ * with _guarded, which uses a guard, and a function suffixed with _manual,
+ * which does the same thing by hand. The two must compile to the same
+ * instructions, or at least to the same calls, in the same order, with
+ * instruction counts that differ by no more than CODEGEN_TOLERANCE (0 by
+ * default). The tolerance is for pairs with branches, such as those that
+ * dismiss, which some compilers lay out differently (e.g. by duplicating a
+ * call on each path) even though the guard adds no work.
+ *
+ * This file is never linked.
+ */
+
+#include "scope_guard.hpp"
+#include "trace_zone.hpp" // without SG_ENABLE_TRACE
+
+using namespace sg;
+
+extern "C"
+{
+  void sg_codegen_work() noexcept; // opaque, so that calls are not reordered
+  void sg_codegen_cleanup() noexcept;
+  bool sg_codegen_try_work() noexcept; // opaque, returns whether it succeeded
+
+  struct sg_codegen_functor
+  {
+    void operator()() const noexcept { sg_codegen_cleanup(); }
+  };
+
+  /* --- scope_guard --- */
+
+  void sg_codegen_lambda_guarded() noexcept
+  {
+    const auto guard = make_scope_guard([]() noexcept { sg_codegen_cleanup(); });
+    sg_codegen_work();
+  }
+
+  void sg_codegen_lambda_manual() noexcept
+  {
+    sg_codegen_work();
+    sg_codegen_cleanup();
+  }
+
+  void sg_codegen_lambda_dismiss_guarded() noexcept
+  {
+    auto guard = make_scope_guard([]() noexcept { sg_codegen_cleanup(); });
+    if(sg_codegen_try_work())
+      guard.dismiss();
+  }
+
+  void sg_codegen_lambda_dismiss_manual() noexcept
+  {
+    if(!sg_codegen_try_work())
+      sg_codegen_cleanup();
+  }
+
+  void sg_codegen_functor_guarded() noexcept
+  {
+    const auto guard = make_scope_guard(sg_codegen_functor{});
+    sg_codegen_work();
+  }
+
+  void sg_codegen_functor_manual() noexcept
+  {
+    sg_codegen_work();
+    sg_codegen_cleanup();
+  }
+
+  void sg_codegen_functor_dismiss_guarded() noexcept
+  {
+    auto guard = make_scope_guard(sg_codegen_functor{});
+    if(sg_codegen_try_work())
+      guard.dismiss();
+  }
+
+  void sg_codegen_functor_dismiss_manual() noexcept
+  {
+    if(!sg_codegen_try_work())
+      sg_codegen_cleanup();
+  }
+
+  void sg_codegen_function_pointer_guarded() noexcept
+  {
+    const auto guard = make_scope_guard(&sg_codegen_cleanup);
+    sg_codegen_work();
+  }
+
+  void sg_codegen_function_pointer_manual() noexcept
+  {
+    sg_codegen_work();
+    sg_codegen_cleanup();
+  }
+
+  void sg_codegen_function_pointer_dismiss_guarded() noexcept
+  {
+    auto guard = make_scope_guard(&sg_codegen_cleanup);
+    if(sg_codegen_try_work())
+      guard.dismiss();
+  }
+
+  void sg_codegen_function_pointer_dismiss_manual() noexcept
+  {
+    if(!sg_codegen_try_work())
+      sg_codegen_cleanup();
+  }
+
+  void sg_codegen_runtime_function_pointer_guarded(void (*f)()) noexcept
+  {
+    const auto guard = make_scope_guard(f);
+    sg_codegen_work();
+  }
+
+  void sg_codegen_runtime_function_pointer_manual(void (*f)()) noexcept
+  {
+    sg_codegen_work();
+    f();
+  }
+
+  /* --- scope_exit --- */
+
+  void sg_codegen_scope_exit_lambda_guarded() noexcept
+  {
+    const auto guard = make_scope_exit([]() noexcept { sg_codegen_cleanup(); });
+    sg_codegen_work();
+  }
+
+  void sg_codegen_scope_exit_lambda_manual() noexcept
+  {
+    sg_codegen_work();
+    sg_codegen_cleanup();
+  }
+
+  void sg_codegen_scope_exit_capture_guarded(int* p) noexcept
+  {
+    const auto guard = make_scope_exit([p]() noexcept { *p = 0; });
+    sg_codegen_work();
+  }
+
+  void sg_codegen_scope_exit_capture_manual(int* p) noexcept
+  {
+    sg_codegen_work();
+    *p = 0;
+  }
+
+  void sg_codegen_scope_exit_functor_guarded() noexcept
+  {
+    const auto guard = make_scope_exit(sg_codegen_functor{});
+    sg_codegen_work();
+  }
+
+  void sg_codegen_scope_exit_functor_manual() noexcept
+  {
+    sg_codegen_work();
+    sg_codegen_cleanup();
+  }
+
+  /* --- multiple callbacks --- */
+
+  void sg_codegen_multi_guarded(int* p) noexcept
+  {
+    const auto guard = make_scope_guard([]() noexcept { sg_codegen_cleanup(); },
+                                        [p]() noexcept { *p = 0; });
+    sg_codegen_work();
+  }
+
+  void sg_codegen_multi_manual(int* p) noexcept
+  {
+    sg_codegen_work();
+    *p = 0;
+    sg_codegen_cleanup();
+  }
+
+  /* --- callbacks known at compile time --- */
+
+#if __cplusplus >= 201703L
+  void sg_codegen_static_function_guarded() noexcept
+  {
+    const auto guard = make_scope_guard<&sg_codegen_cleanup>();
+    sg_codegen_work();
+  }
+
+  void sg_codegen_static_function_manual() noexcept
+  {
+    sg_codegen_work();
+    sg_codegen_cleanup();
+  }
+#endif
+
+  /* --- disabled trace zones --- */
+
+  void sg_codegen_trace_zone_guarded() noexcept
+  {
+    SG_TRACE_ZONE("zone");
+    sg_codegen_work();
+  }
+
+  void sg_codegen_trace_zone_manual() noexcept
+  {
+    sg_codegen_work();
+  }
+}
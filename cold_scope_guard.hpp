@@ -0,0 +1,149 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * See docs/interface.md for documentation of this header's public interface.
+ */
+
+#ifndef COLD_SCOPE_GUARD_HPP_
+#define COLD_SCOPE_GUARD_HPP_
+
+#include "scope_guard.hpp"
+
+#include <type_traits>
+#include <utility>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SG_COLD [[gnu::cold, gnu::noinline]] // also predicts calls as unlikely
+#elif defined(_MSC_VER)
+#define SG_COLD __declspec(noinline)
+#else
+#define SG_COLD
+#endif
+
+#if __cplusplus >= 202002L && defined(__has_cpp_attribute)
+#if __has_cpp_attribute(unlikely)
+#define SG_UNLIKELY [[unlikely]]
+#endif
+#endif
+#ifndef SG_UNLIKELY
+#define SG_UNLIKELY
+#endif
+
+namespace sg
+{
+  namespace detail
+  {
+    /* --- A scope guard that keeps its callback out of the hot path --- */
+
+#ifdef SG_HAS_CONCEPTS
+    template<scope_guard_callback Callback, typename = void>
+#else
+    template<typename Callback,
+             typename = typename std::enable_if<
+               is_proper_sg_callback_t<Callback>::value>::type>
+#endif
+    class cold_scope_guard;
+
+    template<SG_CALLBACK_TYPENAME Callback>
+    cold_scope_guard<Callback> make_cold_scope_guard(Callback&& callback)
+    noexcept(is_nothrow_self_constructible_t<Callback>::value); /*
+    in the inner namespace for the same reason as make_scope_guard */
+
+    template<SG_CALLBACK_TYPENAME Callback>
+    class cold_scope_guard<Callback> final : private callback_storage<Callback>
+    {
+    public:
+      typedef Callback callback_type;
+
+      cold_scope_guard(cold_scope_guard&& other)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value);
+
+      ~cold_scope_guard() noexcept; /* calls back, out of line, unless
+      dismissed (expected) */
+
+      void dismiss() noexcept;
+
+    public:
+      cold_scope_guard() = delete;
+      cold_scope_guard(const cold_scope_guard&) = delete;
+      cold_scope_guard& operator=(const cold_scope_guard&) = delete;
+      cold_scope_guard& operator=(cold_scope_guard&&) = delete;
+
+    private:
+      explicit cold_scope_guard(Callback&& callback)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value); /*
+                                                      meant for friends only */
+
+      friend cold_scope_guard<Callback>
+      make_cold_scope_guard<Callback>(Callback&&)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value);
+
+      SG_COLD static void fire(Callback& callback) noexcept; /* never inlined,
+      so that the callback's body is not either */
+
+    private:
+      bool m_active;
+
+    };
+
+  } // namespace detail
+
+
+  /* --- Now the public maker function --- */
+
+  using detail::make_cold_scope_guard; // see comment on declaration above
+
+} // namespace sg
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+sg::detail::cold_scope_guard<Callback>::cold_scope_guard(Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+  : callback_storage<Callback>(std::forward<Callback>(callback))
+  , m_active{true}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+sg::detail::cold_scope_guard<Callback>::cold_scope_guard(
+  cold_scope_guard&& other)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+  : callback_storage<Callback>(std::forward<Callback>(other.callback()))
+  , m_active{other.m_active}
+{
+  other.m_active = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+sg::detail::cold_scope_guard<Callback>::~cold_scope_guard() noexcept
+{
+  if(m_active) SG_UNLIKELY
+    fire(this->callback());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+inline void sg::detail::cold_scope_guard<Callback>::dismiss() noexcept
+{
+  m_active = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+void sg::detail::cold_scope_guard<Callback>::fire(Callback& callback) noexcept
+{
+  callback();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+inline auto sg::detail::make_cold_scope_guard(Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+-> cold_scope_guard<Callback>
+{
+  return cold_scope_guard<Callback>{std::forward<Callback>(callback)};
+}
+
+#endif /* COLD_SCOPE_GUARD_HPP_ */
@@ -7,6 +7,7 @@
 #include <utility>
 #include <functional>
 #include <stdexcept>
+#include <system_error>
 
 using namespace sg;
 
@@ -138,224 +139,246 @@ namespace
   };
 
 
-  /* --- tests that always succeed --- */
+  /* --- and a static test engine --- */
 
-#ifdef test_1
-    static_assert(noexcept(make_scope_guard(std::declval<void(*)()noexcept>())),
-                  "make_scope_guard not noexcept");
-#endif
+  /* Type trait determining whether make_scope_guard accepts an argument of type
+  T (an lvalue if T is an lvalue reference, an rvalue otherwise) */
+  template<typename T, typename = void>
+  struct make_scope_guard_accepts_t
+    : public std::false_type
+  {}; // in general, false
 
-#ifdef test_2
-    static_assert(noexcept(make_scope_guard(std::declval<void(*)()noexcept>())
-                           .~scope_guard()),
-                  "scope_guard dtor not noexcept");
-#endif
+  template<typename T>
+  struct make_scope_guard_accepts_t<
+    T, decltype(make_scope_guard(std::declval<T>()), void())>
+    : public std::true_type
+  {}; // only true when make_scope_guard(std::declval<T>()) is valid
 
-    /**
-     * Test nothrow character of make_scope_guard for different value categories
-     * of a type with a throwing destructor
-     */
-    void test_throwing_dtor_throw_spec_good()
-    {
-#ifdef test_3
-      potentially_throwing_dtor x;
-      static_assert(noexcept(make_scope_guard(x)),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an lvalue object whose dtor throws (should deduce "
-                    "reference and avoid destruction entirely)");
-#endif
-#ifdef test_4
-      potentially_throwing_dtor x;
-      auto& r = x;
-      static_assert(noexcept(make_scope_guard(r)),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an lvalue reference to an object whose dtor throws "
-                    "(should deduce reference and avoid destruction entirely)");
-#endif
-#ifdef test_5
-      potentially_throwing_dtor x;
-      const auto& cr = x;
-      static_assert(noexcept(make_scope_guard(cr)),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an lvalue reference to a const object whose dtor "
-                    "throws (should deduce reference and avoid destruction "
-                    "entirely)");
-#endif
-    }
+  // whether both make_scope_guard and is_scope_guard_callback accept T
+  template<typename T>
+  struct accepted_t
+    : public std::integral_constant<bool,
+                                    make_scope_guard_accepts_t<T>::value &&
+                                    is_scope_guard_callback<T>::value>
+  {};
 
-    /**
-     * Test nothrow character of make_scope_guard for different value categories
-     * of a type with a throwing copy constructor
-     */
-    void test_throwing_copy_throw_spec()
-    {
-#ifdef test_6
-      static_assert(noexcept(make_scope_guard(throwing_copy{})),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an rvalue object whose copy ctor throws");
-#endif
-#ifdef test_7
-      throwing_copy x;
-      static_assert(noexcept(make_scope_guard(x)),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an lvalue object whose copy ctor throws (should "
-                    "deduce reference and avoid copy entirely)");
-#endif
-#ifdef test_8
-      throwing_copy x;
-      static_assert(noexcept(make_scope_guard(std::move(x))),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an rvalue reference to an object whose copy ctor "
-                    "throws");
-#endif
-#ifdef test_9
-      throwing_copy x;
-      auto& r = x;
-      static_assert(noexcept(make_scope_guard(r)),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an lvalue reference to an object whose copy ctor "
-                    "throws (should deduce reference and avoid copy entirely)");
-#endif
-#ifdef test_10
-      throwing_copy x;
-      const auto& cr = x;
-      static_assert(noexcept(make_scope_guard(cr)),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an lvalue reference to a const object whose copy "
-                    "ctor throws (should deduce reference and avoid copy "
-                    "entirely)");
-#endif
-    }
+  // whether both make_scope_guard and is_scope_guard_callback reject T
+  template<typename T>
+  struct rejected_t
+    : public std::integral_constant<bool,
+                                    !make_scope_guard_accepts_t<T>::value &&
+                                    !is_scope_guard_callback<T>::value>
+  {};
 
-    /**
-     * Test nothrow character of make_scope_guard for different value categories
-     * of a type with a throwing move constructor
-     */
-    void test_throwing_move_throw_spec()
-    {
-#ifdef test_11
-      static_assert(!noexcept(make_scope_guard(throwing_move{})),
-                    "make_scope_guard wrongly declared noexcept when instanced "
-                    "with an rvalue object whose move ctor throws");
-#endif
-#ifdef test_12
-      throwing_move x;
-      static_assert(noexcept(make_scope_guard(x)),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an lvalue object whose move ctor throws");
-#endif
-#ifdef test_13
-      throwing_move x;
-      static_assert(!noexcept(make_scope_guard(std::move(x))),
-                    "make_scope_guard wrongly declared noexcept when instanced "
-                    "with an rvalue reference to an object whose move ctor "
-                    "throws");
-#endif
-#ifdef test_14
-      throwing_move x;
-      auto& r = x;
-      static_assert(noexcept(make_scope_guard(r)),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an lvalue reference to an object whose move ctor "
-                    "throws");
-#endif
-#ifdef test_15
-      throwing_move x;
-      const auto& cr = x;
-      static_assert(noexcept(make_scope_guard(cr)),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an lvalue reference to a const object whose move "
-                    "ctor throws");
+  // whether T is accepted, unless nothrow invocation is required
+  template<typename T>
+  struct accepted_unless_noexcept_required_t
+#ifdef SG_REQUIRE_NOEXCEPT
+    : public rejected_t<T>
+#else
+    : public accepted_t<T>
 #endif
-    }
+  {};
 
-    /**
-     * Test nothrow character of make_scope_guard for different value categories
-     * of a type with a throwing copy constructor
-     */
-    void test_nomove_throwing_copy_throw_spec()
-    {
-#ifdef test_16
-      static_assert(!noexcept(make_scope_guard(nomove_throwing_copy{})),
-                    "make_scope_guard wrongly declared noexcept when instanced "
-                    "with an rvalue object whose copy ctor throws and without "
-                    "a move ctor");
-#endif
-#ifdef test_17
-      nomove_throwing_copy x;
-      static_assert(noexcept(make_scope_guard(x)),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an lvalue object whose copy ctor throws and without "
-                    "a move ctor (should deduce reference and avoid copy "
-                    "entirely)");
-#endif
-#ifdef test_18
-      nomove_throwing_copy x;
-      static_assert(!noexcept(make_scope_guard(std::move(x))),
-                    "make_scope_guard wrongly declared noexcept when instanced "
-                    "with an rvalue reference to an object whose copy ctor "
-                    "throws and without a move ctor");
-#endif
-#ifdef test_19
-      nomove_throwing_copy x;
-      auto& r = x;
-      static_assert(noexcept(make_scope_guard(r)),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an lvalue reference to an object whose copy ctor "
-                    "throws (should deduce reference and avoid copy entirely)");
-#endif
-#ifdef test_20
-      nomove_throwing_copy x;
-      const auto& cr = x;
-      static_assert(noexcept(make_scope_guard(cr)),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an lvalue reference to a const object whose copy "
-                    "ctor throws (should deduce reference and avoid copy "
-                    "entirely)");
-#endif
-    }
+  /* Type trait determining whether make_status_guard accepts a status of type
+  S (an lvalue if S is an lvalue reference, an rvalue otherwise), with a proper
+  callback */
+  template<typename S, typename = void>
+  struct make_status_guard_accepts_t
+    : public std::false_type
+  {}; // in general, false
+
+  template<typename S>
+  struct make_status_guard_accepts_t<
+    S, decltype(make_status_guard(std::declval<S>(), non_throwing), void())>
+    : public std::true_type
+  {}; // only true when make_status_guard(std::declval<S>(), ...) is valid
+
+  /* Type trait determining whether make_token_guard accepts a token of type T
+  (an lvalue if T is an lvalue reference, an rvalue otherwise), with a proper
+  callback */
+  template<typename T, typename = void>
+  struct make_token_guard_accepts_t
+    : public std::false_type
+  {}; // in general, false
 
-    /**
-     * Test nothrow character of make_scope_guard for different value categories
-     * of a type with a non-throwing constructors and destructor
-     */
-    void test_nothrow_throw_spec()
-    {
-#ifdef test_21
-      static_assert(noexcept(make_scope_guard(nothrow{})),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an rvalue object whose ctors and dtor do not throw");
-#endif
-#ifdef test_22
-      nothrow x;
-      static_assert(noexcept(make_scope_guard(x)),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an lvalue object whose ctors and dtor do not throw");
-#endif
-#ifdef test_23
-      nothrow x;
-      static_assert(noexcept(make_scope_guard(std::move(x))),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an rvalue reference to an object whose ctors and "
-                    "dtor do not throw");
-#endif
-#ifdef test_24
-      nothrow x;
-      auto& r = x;
-      static_assert(noexcept(make_scope_guard(r)),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an lvalue reference to an object whose ctors and "
-                    "dtor do not throw");
-#endif
-#ifdef test_25
-      nothrow x;
-      const auto& cr = x;
-      static_assert(noexcept(make_scope_guard(cr)),
-                    "make_scope_guard not declared noexcept when instanced "
-                    "with an lvalue reference to a const object whose ctors "
-                    "dtor do not throw");
-#endif
-    }
+  template<typename T>
+  struct make_token_guard_accepts_t<
+    T, decltype(make_token_guard(std::declval<T>(), non_throwing), void())>
+    : public std::true_type
+  {}; // only true when make_token_guard(std::declval<T>(), ...) is valid
+
+  struct throwing_status
+  {
+    explicit operator bool() const { return true; } // not noexcept
+  };
+
+  // Type trait determining whether a (possibly const) guard can be dismissed
+  template<typename T, typename = void>
+  struct is_dismissible_t
+    : public std::false_type
+  {}; // in general, false
+
+  template<typename T>
+  struct is_dismissible_t<T, decltype(std::declval<T&>().dismiss())>
+    : public std::true_type
+  {}; // only true when dismiss valid
+
+
+  /* --- tests that always succeed --- */
+
+  static_assert(noexcept(make_scope_guard(std::declval<void(*)()noexcept>())),
+                "make_scope_guard not noexcept");
+
+  static_assert(noexcept(make_scope_guard(std::declval<void(*)()noexcept>())
+                         .~scope_guard()),
+                "scope_guard dtor not noexcept");
+
+  /**
+   * Test nothrow character of make_scope_guard for different value categories
+   * of a type with a throwing destructor
+   */
+  void test_throwing_dtor_throw_spec_good()
+  {
+    potentially_throwing_dtor x;
+    auto& r = x;
+    const auto& cr = x;
+    static_assert(noexcept(make_scope_guard(x)),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an lvalue object whose dtor throws (should deduce "
+                  "reference and avoid destruction entirely)");
+    static_assert(noexcept(make_scope_guard(r)),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an lvalue reference to an object whose dtor throws "
+                  "(should deduce reference and avoid destruction entirely)");
+    static_assert(noexcept(make_scope_guard(cr)),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an lvalue reference to a const object whose dtor "
+                  "throws (should deduce reference and avoid destruction "
+                  "entirely)");
+  }
+
+  /**
+   * Test nothrow character of make_scope_guard for different value categories
+   * of a type with a throwing copy constructor
+   */
+  void test_throwing_copy_throw_spec()
+  {
+    throwing_copy x;
+    auto& r = x;
+    const auto& cr = x;
+    static_assert(noexcept(make_scope_guard(throwing_copy{})),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an rvalue object whose copy ctor throws");
+    static_assert(noexcept(make_scope_guard(x)),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an lvalue object whose copy ctor throws (should "
+                  "deduce reference and avoid copy entirely)");
+    static_assert(noexcept(make_scope_guard(std::move(x))),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an rvalue reference to an object whose copy ctor "
+                  "throws");
+    static_assert(noexcept(make_scope_guard(r)),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an lvalue reference to an object whose copy ctor "
+                  "throws (should deduce reference and avoid copy entirely)");
+    static_assert(noexcept(make_scope_guard(cr)),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an lvalue reference to a const object whose copy "
+                  "ctor throws (should deduce reference and avoid copy "
+                  "entirely)");
+  }
+
+  /**
+   * Test nothrow character of make_scope_guard for different value categories
+   * of a type with a throwing move constructor
+   */
+  void test_throwing_move_throw_spec()
+  {
+    throwing_move x;
+    auto& r = x;
+    const auto& cr = x;
+    static_assert(!noexcept(make_scope_guard(throwing_move{})),
+                  "make_scope_guard wrongly declared noexcept when instanced "
+                  "with an rvalue object whose move ctor throws");
+    static_assert(noexcept(make_scope_guard(x)),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an lvalue object whose move ctor throws");
+    static_assert(!noexcept(make_scope_guard(std::move(x))),
+                  "make_scope_guard wrongly declared noexcept when instanced "
+                  "with an rvalue reference to an object whose move ctor "
+                  "throws");
+    static_assert(noexcept(make_scope_guard(r)),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an lvalue reference to an object whose move ctor "
+                  "throws");
+    static_assert(noexcept(make_scope_guard(cr)),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an lvalue reference to a const object whose move "
+                  "ctor throws");
+  }
+
+  /**
+   * Test nothrow character of make_scope_guard for different value categories
+   * of a type with a throwing copy constructor
+   */
+  void test_nomove_throwing_copy_throw_spec()
+  {
+    nomove_throwing_copy x;
+    auto& r = x;
+    const auto& cr = x;
+    static_assert(!noexcept(make_scope_guard(nomove_throwing_copy{})),
+                  "make_scope_guard wrongly declared noexcept when instanced "
+                  "with an rvalue object whose copy ctor throws and without "
+                  "a move ctor");
+    static_assert(noexcept(make_scope_guard(x)),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an lvalue object whose copy ctor throws and without "
+                  "a move ctor (should deduce reference and avoid copy "
+                  "entirely)");
+    static_assert(!noexcept(make_scope_guard(std::move(x))),
+                  "make_scope_guard wrongly declared noexcept when instanced "
+                  "with an rvalue reference to an object whose copy ctor "
+                  "throws and without a move ctor");
+    static_assert(noexcept(make_scope_guard(r)),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an lvalue reference to an object whose copy ctor "
+                  "throws (should deduce reference and avoid copy entirely)");
+    static_assert(noexcept(make_scope_guard(cr)),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an lvalue reference to a const object whose copy "
+                  "ctor throws (should deduce reference and avoid copy "
+                  "entirely)");
+  }
+
+  /**
+   * Test nothrow character of make_scope_guard for different value categories
+   * of a type with a non-throwing constructors and destructor
+   */
+  void test_nothrow_throw_spec()
+  {
+    nothrow x;
+    auto& r = x;
+    const auto& cr = x;
+    static_assert(noexcept(make_scope_guard(nothrow{})),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an rvalue object whose ctors and dtor do not throw");
+    static_assert(noexcept(make_scope_guard(x)),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an lvalue object whose ctors and dtor do not throw");
+    static_assert(noexcept(make_scope_guard(std::move(x))),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an rvalue reference to an object whose ctors and "
+                  "dtor do not throw");
+    static_assert(noexcept(make_scope_guard(r)),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an lvalue reference to an object whose ctors and "
+                  "dtor do not throw");
+    static_assert(noexcept(make_scope_guard(cr)),
+                  "make_scope_guard not declared noexcept when instanced "
+                  "with an lvalue reference to a const object whose ctors "
+                  "dtor do not throw");
+  }
 
   /**
    * Test compilation successes with wrong usage of non-copyable and non-movable
@@ -363,20 +386,18 @@ namespace
    */
   void test_noncopyable_nonmovable_good()
   {
-#ifdef test_26
-    nocopy_nomove ncnm{};
-    make_scope_guard(ncnm);
-#endif
-#ifdef test_27
     nocopy_nomove ncnm{};
     auto& ncnmr = ncnm;
-    make_scope_guard(ncnmr);
-#endif
-#ifdef test_28
-    nocopy_nomove ncnm{};
     const auto& ncnmcr = ncnm;
+    make_scope_guard(ncnm);
+    make_scope_guard(ncnmr);
     make_scope_guard(ncnmcr);
-#endif
+
+    static_assert(accepted_t<nocopy_nomove&>::value,
+                  "lvalue of a non-copyable and non-movable type rejected");
+    static_assert(accepted_t<const nocopy_nomove&>::value,
+                  "const lvalue of a non-copyable and non-movable type "
+                  "rejected");
   }
 
   /**
@@ -384,18 +405,12 @@ namespace
    */
   void test_dismiss_is_noexcept()
   {
-#ifdef test_29
     static_assert(noexcept(make_scope_guard(non_throwing).dismiss()),
                   "scope_guard::dismiss not noexcept");
-#endif
-#ifdef test_30
     static_assert(noexcept(make_scope_guard(non_throwing_lambda).dismiss()),
                   "scope_guard::dismiss not noexcept");
-#endif
-#ifdef test_31
     static_assert(noexcept(make_scope_guard(non_throwing_functor).dismiss()),
                   "scope_guard::dismiss not noexcept");
-#endif
   }
 
   /**
@@ -403,238 +418,248 @@ namespace
    */
   void test_noexcept_good()
   {
-#ifdef test_32
     make_scope_guard(non_throwing);
-#endif
-#ifdef test_33
     make_scope_guard(non_throwing_lambda);
-#endif
-#ifdef test_34
     make_scope_guard(non_throwing_functor);
-#endif
+
+    static_assert(accepted_t<decltype(non_throwing)&>::value,
+                  "noexcept function rejected");
+    static_assert(accepted_t<decltype(non_throwing_lambda)&>::value,
+                  "noexcept lambda rejected");
+    static_assert(accepted_t<decltype(non_throwing_functor)&>::value,
+                  "noexcept functor rejected");
+    static_assert(accepted_t<non_throwing_struct>::value,
+                  "noexcept functor rvalue rejected");
+  }
+
+  /**
+   * Test that make_status_guard accepts statuses that convert to bool without
+   * throwing, but only as lvalues (the guard would outlive a temporary)
+   */
+  void test_status_guard_statuses()
+  {
+    static_assert(make_status_guard_accepts_t<std::error_code&>::value,
+                  "std::error_code status rejected");
+    static_assert(make_status_guard_accepts_t<const int&>::value,
+                  "int status rejected");
+    static_assert(make_status_guard_accepts_t<void* const&>::value,
+                  "pointer status rejected");
+    static_assert(!make_status_guard_accepts_t<std::error_code>::value,
+                  "temporary status accepted");
+    static_assert(!make_status_guard_accepts_t<throwing_status&>::value,
+                  "status with a throwing conversion accepted");
+    static_assert(!make_status_guard_accepts_t<nocopy_nomove&>::value,
+                  "status without a conversion to bool accepted");
+    static_assert(noexcept(make_status_guard(std::declval<int&>(),
+                                             non_throwing)),
+                  "make_status_guard not noexcept");
+  }
+
+  /**
+   * Test that make_token_guard accepts tokens only as lvalues (the guard would
+   * outlive a temporary)
+   */
+  void test_token_guard_tokens()
+  {
+    static_assert(make_token_guard_accepts_t<commit_token&>::value,
+                  "token rejected");
+    static_assert(make_token_guard_accepts_t<const commit_token&>::value,
+                  "const token rejected");
+    static_assert(!make_token_guard_accepts_t<commit_token>::value,
+                  "temporary token accepted");
+    static_assert(!make_token_guard_accepts_t<const commit_token>::value,
+                  "temporary const token accepted");
   }
 
   /* --- tests that fail iff nothrow_invocable is required --- */
 
   /**
    * Highlight that scope_guard should not be created with throwing callables,
-   * under penalty of an immediate std::terminate call. Test that compilation
-   * fails on such an attempt when noexcept is required.
+   * under penalty of an immediate std::terminate call. Test that they are
+   * rejected when noexcept is required.
    */
   void test_noexcept_bad()
   {
-#ifdef test_35
-    make_scope_guard(throwing);
-#endif
-#ifdef test_36
-    make_scope_guard(throwing_stdfun);
-#endif
-#ifdef test_37
-    make_scope_guard(throwing_lambda);
-#endif
-#ifdef test_38
-    make_scope_guard(throwing_bound);
-#endif
-#ifdef test_39
-    make_scope_guard(throwing_functor);
-#endif
+    static_assert(
+      accepted_unless_noexcept_required_t<decltype(throwing)&>::value,
+      "throwing function accepted or rejected wrongly");
+    static_assert(
+      accepted_unless_noexcept_required_t<decltype(throwing_stdfun)&>::value,
+      "throwing std::function accepted or rejected wrongly");
+    static_assert(
+      accepted_unless_noexcept_required_t<decltype(throwing_lambda)&>::value,
+      "throwing lambda accepted or rejected wrongly");
+    static_assert(
+      accepted_unless_noexcept_required_t<decltype(throwing_bound)&>::value,
+      "throwing bind expression accepted or rejected wrongly");
+    static_assert(
+      accepted_unless_noexcept_required_t<decltype(throwing_functor)&>::value,
+      "throwing functor accepted or rejected wrongly");
   }
 
   /**
    * Highlight the importance of declaring scope_guard callables noexcept
-   * (when they do not throw). Test that compilation fails on attempts to the
-   * contrary when noexcept is required.
+   * (when they do not throw). Test that they are rejected otherwise, when
+   * noexcept is required.
    */
   void test_noexcept_fixable()
   {
-#ifdef test_40
-    make_scope_guard(meh);
-#endif
-#ifdef test_41
-    make_scope_guard(meh_stdfun);
-#endif
-#ifdef test_42
-    make_scope_guard(meh_lambda);
-#endif
-#ifdef test_43
-    make_scope_guard(meh_bound);
-#endif
-#ifdef test_44
-    make_scope_guard(meh_functor);
-#endif
+    static_assert(accepted_unless_noexcept_required_t<decltype(meh)&>::value,
+                  "non-noexcept function accepted or rejected wrongly");
+    static_assert(
+      accepted_unless_noexcept_required_t<decltype(meh_stdfun)&>::value,
+      "non-noexcept std::function accepted or rejected wrongly");
+    static_assert(
+      accepted_unless_noexcept_required_t<decltype(meh_lambda)&>::value,
+      "non-noexcept lambda accepted or rejected wrongly");
+    static_assert(
+      accepted_unless_noexcept_required_t<decltype(meh_bound)&>::value,
+      "non-noexcept bind expression accepted or rejected wrongly");
+    static_assert(
+      accepted_unless_noexcept_required_t<decltype(meh_functor)&>::value,
+      "non-noexcept functor accepted or rejected wrongly");
   }
 
   /**
    * Highlight that some callables cannot be declared noexcept even if they are
-   * known not to throw. Show that trying to create scope_guards with such
-   * objects unfortunately (but unavoidably AFAIK) breaks compilation when
-   * noexcept is required
+   * known not to throw. Show that such objects are unfortunately (but
+   * unavoidably AFAIK) rejected when noexcept is required
    */
   void test_noexcept_unfortunate()
   {
-#ifdef test_45
-    make_scope_guard(non_throwing_stdfun);
-#endif
-#ifdef test_46
-    make_scope_guard(non_throwing_bound);
-#endif
+    static_assert(
+      accepted_unless_noexcept_required_t<
+        decltype(non_throwing_stdfun)&>::value,
+      "non-throwing std::function accepted or rejected wrongly");
+    static_assert(
+      accepted_unless_noexcept_required_t<decltype(non_throwing_bound)&>::value,
+      "non-throwing bind expression accepted or rejected wrongly");
   }
 
   void test_dismiss_is_noexcept_even_if_bad_callable()
   {
-#ifdef test_47
+#ifndef SG_REQUIRE_NOEXCEPT // otherwise, make_scope_guard rejects these
     static_assert(noexcept(make_scope_guard(throwing).dismiss()),
                   "scope_guard::dismiss not noexcept");
-#endif
-#ifdef test_48
     static_assert(noexcept(make_scope_guard(throwing_stdfun).dismiss()),
                   "scope_guard::dismiss not noexcept");
-#endif
-#ifdef test_49
     static_assert(noexcept(make_scope_guard(throwing_lambda).dismiss()),
                   "scope_guard::dismiss not noexcept");
-#endif
-#ifdef test_50
     static_assert(noexcept(make_scope_guard(throwing_bound).dismiss()),
                   "scope_guard::dismiss not noexcept");
-#endif
-#ifdef test_51
     static_assert(noexcept(make_scope_guard(throwing_functor).dismiss()),
                   "scope_guard::dismiss not noexcept");
 #endif
   }
 
 
-  /* --- tests that always fail --- */
+  /* --- tests that always fail (statically) --- */
 
   void test_throwing_dtor_throw_spec_bad()
   {
-#ifdef test_52
-    make_scope_guard(potentially_throwing_dtor{});
-#endif
-#ifdef test_53
-    potentially_throwing_dtor x;
-    make_scope_guard(std::move(x));
-#endif
+    static_assert(rejected_t<potentially_throwing_dtor>::value,
+                  "rvalue whose dtor throws accepted");
   }
 
   /**
-   * Test that compilation fails when trying to copy-construct a scope_guard
+   * Test that scope_guards cannot be copy-constructed, copy-assigned or
+   * move-assigned
    */
-  void test_disallowed_copy_construction()
+  void test_disallowed_copy_and_assignment()
   {
-    const auto guard1 = make_scope_guard(non_throwing);
-#ifdef test_54
-    const auto guard2 = guard1;
-#endif
+    using guard_t = decltype(make_scope_guard(non_throwing));
+    static_assert(!std::is_copy_constructible<guard_t>::value,
+                  "scope_guard copy-constructible");
+    static_assert(!std::is_copy_assignable<guard_t>::value,
+                  "scope_guard copy-assignable");
+    static_assert(!std::is_move_assignable<guard_t>::value,
+                  "scope_guard move-assignable");
   }
 
   /**
-   * Test that compilation fails when trying to copy-assign a scope_guard
+   * Test that returning callables are rejected
    */
-  void test_disallowed_copy_assignment()
+  void test_disallowed_return()
   {
-    const auto guard1 = make_scope_guard(non_throwing_lambda);
-    auto guard2 = make_scope_guard(non_throwing_functor);
-#ifdef test_55
-    guard2 = guard1;
-#endif
+    static_assert(rejected_t<decltype(returning)&>::value,
+                  "returning function accepted");
+    static_assert(rejected_t<decltype(returning_stdfun)&>::value,
+                  "returning std::function accepted");
+    static_assert(rejected_t<decltype(returning_lambda)&>::value,
+                  "returning lambda accepted");
+    static_assert(rejected_t<decltype(returning_bound)&>::value,
+                  "returning bind expression accepted");
+    static_assert(rejected_t<decltype(returning_functor)&>::value,
+                  "returning functor accepted");
   }
 
   /**
-   * Test that compilation fails when trying to move-assign a scope_guard
+   * Test that rvalues of non-copyable and non-movable types are rejected
    */
-  void test_disallowed_move_assignment()
+  void test_noncopyable_nonmovable_bad()
   {
-    auto guard = make_scope_guard(non_throwing);
-#ifdef test_56
-    guard = make_scope_guard(non_throwing_lambda);
-#endif
+    static_assert(rejected_t<nocopy_nomove>::value,
+                  "rvalue of a non-copyable and non-movable type accepted");
   }
 
   /**
-   * Test that compilation fails when trying to use a returning function to
-   * create a scope_guard
+   * Test that scope guards cannot be created from a callback directly through
+   * their constructor (see also the failing builds below)
    */
-  void test_disallowed_return()
+  void test_direct_construction_forbidden()
   {
-#ifdef test_57
-    make_scope_guard(returning);
-#endif
-#ifdef test_58
-    make_scope_guard(returning_stdfun);
-#endif
-#ifdef test_59
-    make_scope_guard(returning_lambda);
-#endif
-#ifdef test_60
-    make_scope_guard(returning_bound);
-#endif
-#ifdef test_61
-    make_scope_guard(returning_functor);
-#endif
+    static_assert(!std::is_constructible<
+                    detail::scope_guard<void(&)()noexcept>,
+                    void(&)()noexcept>::value,
+                  "scope_guard directly constructible from a function");
+    static_assert(!std::is_constructible<
+                    detail::scope_guard<non_throwing_struct>,
+                    non_throwing_struct&&>::value,
+                  "scope_guard directly constructible from a functor");
   }
 
   /**
-   * Test compilation failures with wrong usage of non-copyable and non-movable
-   * objects to create scope_guards
+   * Test that const scope guards cannot be dismissed or moved
    */
-  void test_noncopyable_nonmovable_bad()
+  void test_const_guard_cannot_do_everything()
   {
-#ifdef test_62
-    make_scope_guard(nocopy_nomove{});
-#endif
-#ifdef test_63
-    nocopy_nomove ncnm{};
-    make_scope_guard(std::move(ncnm));
-#endif
+    using guard_t = decltype(make_scope_guard(non_throwing));
+    static_assert(is_dismissible_t<guard_t>::value,
+                  "scope_guard not dismissible");
+    static_assert(!is_dismissible_t<const guard_t>::value,
+                  "const scope_guard dismissible");
+    static_assert(std::is_move_constructible<guard_t>::value,
+                  "scope_guard not move-constructible");
+    static_assert(!std::is_constructible<guard_t, const guard_t&&>::value,
+                  "const scope_guard movable");
   }
 
+
+  /* --- tests that fail to build (one per test_N macro) --- */
+
   /**
-   * Test compilation failures when trying to create a scope guard from a
-   * callback directly through its constructor
+   * Test compilation failures when trying to create a scope guard through its
+   * constructor, with class template argument deduction
    */
-  void test_direct_construction_forbidden()
+  void test_deduced_construction_forbidden()
   {
-#ifdef test_64
+#ifdef test_1
     detail::scope_guard{non_throwing};
 #endif
-#ifdef test_65
+#ifdef test_2
     auto x = detail::scope_guard(non_throwing);
-#endif
-#ifdef test_66
-    auto x = detail::scope_guard<void(&)()noexcept>{non_throwing};
-#endif
-#ifdef test_67
-    auto lambda = []() noexcept {};
-    detail::scope_guard<decltype(lambda)>{std::move(lambda)};
-#endif
-  }
-
-  /**
-   * Test compilation failures when trying to use modifying operations on a
-   * const scope guard
-   */
-  void test_const_guard_cannot_do_everything()
-  {
-    const auto guard = make_scope_guard(non_throwing);
-#ifdef test_68
-    guard.dismiss();
-#endif
-#ifdef test_69
-    auto another = std::move(guard);
 #endif
   }
 
   /**
    * Test compilation failures when trying to inherit from scope_guard
    */
-#ifdef test_70
+#ifdef test_3
   struct concrete_specialized_guard
     : detail::scope_guard<void(*)()noexcept>
   {};
 #endif
-#ifdef test_71
+#ifdef test_4
   template<typename T>
   struct specialized_guard : detail::scope_guard<T>
   {
@@ -665,18 +690,18 @@ int main()
   test_dismiss_is_noexcept();
   test_noexcept_good();
 
-  test_noexcept_bad(); // this results in a call to std::terminate
+  test_noexcept_bad();
   test_noexcept_fixable();
   test_noexcept_unfortunate();
   test_dismiss_is_noexcept_even_if_bad_callable();
 
   test_throwing_dtor_throw_spec_bad();
-  test_disallowed_copy_construction();
-  test_disallowed_copy_assignment();
-  test_disallowed_move_assignment();
+  test_disallowed_copy_and_assignment();
   test_disallowed_return();
   test_noncopyable_nonmovable_bad();
   test_direct_construction_forbidden();
+  test_const_guard_cannot_do_everything();
+  test_deduced_construction_forbidden();
 
   return 0;
 }
@@ -0,0 +1,222 @@
+/*
+ *  Created on: 15/10/2026
+ *      Author: ricab
+ *
+ * See docs/interface.md for documentation of this header's public interface.
+ */
+
+#ifndef GUARD_STACK_HPP_
+#define GUARD_STACK_HPP_
+
+#include "any_scope_guard.hpp" // for the type erasure
+#include "scope_guard.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sg
+{
+  namespace detail
+  {
+    // A buffer with room for one type-erased callback holder
+    template<std::size_t Size>
+    struct erased_slot
+    {
+      alignas(std::max_align_t) unsigned char m_buffer[Size];
+      const erased_callback_ops* m_ops;
+    };
+
+  } // namespace detail
+
+
+  /* --- A stack of type-erased guards, with inline storage for N --- */
+
+  template<std::size_t N, std::size_t SlotSize = 3 * sizeof(void*)>
+  class guard_stack final
+  {
+  public:
+    static_assert(N > 0, "guard_stack needs at least one inline slot");
+
+    guard_stack() noexcept;
+    ~guard_stack() noexcept; // calls back active callbacks, last pushed first
+
+    template<typename Callback>
+    auto push(Callback&& callback)
+    -> typename std::enable_if<
+         detail::is_proper_sg_callback_t<Callback>::value>::type;
+
+    void dismiss_all() noexcept; // dismisses every callback pushed so far
+    void commit() noexcept; // same as dismiss_all
+
+    std::size_t size() const noexcept;
+
+  public:
+    guard_stack(const guard_stack&) = delete;
+    guard_stack(guard_stack&&) = delete;
+    guard_stack& operator=(const guard_stack&) = delete;
+    guard_stack& operator=(guard_stack&&) = delete;
+
+  private:
+    typedef detail::erased_slot<SlotSize> slot;
+
+    static constexpr std::size_t chunk_capacity = N < 16 ? 16 : N;
+
+    struct chunk // heap storage for callbacks beyond N
+    {
+      chunk* m_previous;
+      slot m_slots[chunk_capacity];
+    };
+
+    template<typename Callback>
+    static void emplace(slot& s, Callback&& callback)
+    noexcept(detail::is_nothrow_self_constructible_t<Callback>::value);
+
+    static void release(slot& s, bool call_back) noexcept;
+
+    template<typename Callback>
+    [[noreturn]] static void fail_allocation(Callback& callback); /* calls
+    back and throws std::bad_alloc, or aborts without exceptions */
+
+  private:
+    slot m_slots[N];
+    chunk* m_overflow; // the newest chunk, if any
+    std::size_t m_size;
+    std::size_t m_dismissed; // callbacks below this index are dismissed
+    bool m_needs_destroy; // whether any callback is not trivially destructible
+
+  };
+
+} // namespace sg
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t N, std::size_t SlotSize>
+constexpr std::size_t sg::guard_stack<N, SlotSize>::chunk_capacity;
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t N, std::size_t SlotSize>
+sg::guard_stack<N, SlotSize>::guard_stack() noexcept
+  : m_overflow{nullptr}
+  , m_size{0}
+  , m_dismissed{0}
+  , m_needs_destroy{false}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t N, std::size_t SlotSize>
+sg::guard_stack<N, SlotSize>::~guard_stack() noexcept
+{
+  const auto unwind = m_dismissed < m_size || m_needs_destroy; /* otherwise,
+  there is nothing to do besides freeing the heap */
+  auto i = m_size;
+
+  while(m_overflow)
+  {
+    if(unwind)
+      for(auto j = (i - N - 1) % chunk_capacity + 1; j-- > 0; --i)
+        release(m_overflow->m_slots[j], i > m_dismissed);
+    else
+      i -= (i - N - 1) % chunk_capacity + 1;
+
+    std::unique_ptr<chunk> newest{m_overflow};
+    m_overflow = m_overflow->m_previous;
+  }
+
+  if(unwind)
+    for(; i > 0; --i)
+      release(m_slots[i - 1], i > m_dismissed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t N, std::size_t SlotSize>
+template<typename Callback>
+auto sg::guard_stack<N, SlotSize>::push(Callback&& callback)
+-> typename std::enable_if<
+     detail::is_proper_sg_callback_t<Callback>::value>::type
+{
+  if(m_size < N)
+    emplace(m_slots[m_size], std::forward<Callback>(callback));
+  else if(const auto offset = (m_size - N) % chunk_capacity)
+    emplace(m_overflow->m_slots[offset], std::forward<Callback>(callback));
+  else
+  { // only link the new chunk if the callback was successfully constructed
+    std::unique_ptr<chunk> added{new(std::nothrow) chunk};
+    if(!added)
+      fail_allocation(callback); // before consuming it
+    emplace(added->m_slots[0], std::forward<Callback>(callback));
+    added->m_previous = m_overflow;
+    m_overflow = added.release();
+  }
+
+  m_needs_destroy = m_needs_destroy || !std::is_trivially_destructible<
+    detail::callback_holder<Callback>>::value;
+  ++m_size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t N, std::size_t SlotSize>
+inline void sg::guard_stack<N, SlotSize>::dismiss_all() noexcept
+{
+  m_dismissed = m_size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t N, std::size_t SlotSize>
+inline void sg::guard_stack<N, SlotSize>::commit() noexcept
+{
+  dismiss_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t N, std::size_t SlotSize>
+inline std::size_t sg::guard_stack<N, SlotSize>::size() const noexcept
+{
+  return m_size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t N, std::size_t SlotSize>
+template<typename Callback>
+inline void sg::guard_stack<N, SlotSize>::emplace(slot& s,
+                                                  Callback&& callback)
+noexcept(detail::is_nothrow_self_constructible_t<Callback>::value)
+{
+  typedef detail::callback_holder<Callback> holder;
+  static_assert(detail::fits_buffer_t<Callback, SlotSize>::value,
+                "callback too large (or over-aligned) for guard_stack's "
+                "SlotSize");
+
+  ::new(static_cast<void*>(s.m_buffer))
+    holder(std::forward<Callback>(callback));
+  s.m_ops = &detail::erased_callback<holder>::ops;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t N, std::size_t SlotSize>
+inline void sg::guard_stack<N, SlotSize>::release(slot& s, bool call_back)
+noexcept
+{
+  if(call_back)
+    s.m_ops->invoke(s.m_buffer);
+  if(s.m_ops->destroy)
+    s.m_ops->destroy(s.m_buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t N, std::size_t SlotSize>
+template<typename Callback>
+void sg::guard_stack<N, SlotSize>::fail_allocation(Callback& callback)
+{
+#ifdef SG_NO_EXCEPTIONS
+  static_cast<void>(callback);
+  std::abort(); // as the standard containers do, without exceptions
+#else
+  callback(); // as its guard would, if it could not be pushed into a vector
+  throw std::bad_alloc{};
+#endif
+}
+
+#endif /* GUARD_STACK_HPP_ */
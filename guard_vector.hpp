@@ -0,0 +1,197 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * See docs/interface.md for documentation of this header's public interface.
+ */
+
+#ifndef GUARD_VECTOR_HPP_
+#define GUARD_VECTOR_HPP_
+
+#include "scope_guard.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sg
+{
+  /* --- A vector of guards, relocated bitwise on growth when possible --- */
+
+  template<typename Guard>
+  class guard_vector final
+  {
+  public:
+    static_assert(std::is_nothrow_move_constructible<Guard>::value,
+                  "guard_vector needs guards that are nothrow movable");
+    static_assert(alignof(Guard) <= alignof(std::max_align_t),
+                  "guard_vector does not support over-aligned guards");
+
+    static constexpr bool relocates_bitwise =
+      is_trivially_relocatable<Guard>::value;
+
+    guard_vector() noexcept;
+    ~guard_vector() noexcept; // destroys guards, last pushed first
+
+    void push_back(Guard&& guard); // may grow, relocating existing guards
+    void reserve(std::size_t capacity); // idem
+
+    void dismiss_all() noexcept; // dismisses every guard pushed so far
+    void commit() noexcept; // same as dismiss_all
+
+    Guard& operator[](std::size_t index) noexcept;
+    std::size_t size() const noexcept;
+    std::size_t capacity() const noexcept;
+
+  public:
+    guard_vector(const guard_vector&) = delete;
+    guard_vector(guard_vector&&) = delete;
+    guard_vector& operator=(const guard_vector&) = delete;
+    guard_vector& operator=(guard_vector&&) = delete;
+
+  private:
+    static constexpr std::size_t initial_capacity = 16;
+
+    void reallocate(std::size_t capacity);
+    [[noreturn]] static void fail_allocation(); /* throws std::bad_alloc, or
+    aborts without exceptions */
+
+  private:
+    Guard* m_data; // from std::malloc, so that it can be std::realloc'ed
+    std::size_t m_size;
+    std::size_t m_capacity;
+
+  };
+
+} // namespace sg
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Guard>
+constexpr bool sg::guard_vector<Guard>::relocates_bitwise;
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Guard>
+constexpr std::size_t sg::guard_vector<Guard>::initial_capacity;
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Guard>
+sg::guard_vector<Guard>::guard_vector() noexcept
+  : m_data{nullptr}
+  , m_size{0}
+  , m_capacity{0}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Guard>
+sg::guard_vector<Guard>::~guard_vector() noexcept
+{
+  for(auto i = m_size; i > 0; --i)
+    m_data[i - 1].~Guard();
+  std::free(m_data);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Guard>
+void sg::guard_vector<Guard>::push_back(Guard&& guard)
+{
+  if(m_size == m_capacity)
+    reallocate(m_capacity ? 2 * m_capacity : initial_capacity); /* on failure,
+    guard is left untouched (and active) */
+
+  ::new(static_cast<void*>(m_data + m_size)) Guard(std::move(guard));
+  ++m_size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Guard>
+void sg::guard_vector<Guard>::reserve(std::size_t capacity)
+{
+  if(capacity > m_capacity)
+    reallocate(capacity);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Guard>
+inline void sg::guard_vector<Guard>::dismiss_all() noexcept
+{
+  for(auto i = std::size_t{0}; i < m_size; ++i)
+    m_data[i].dismiss();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Guard>
+inline void sg::guard_vector<Guard>::commit() noexcept
+{
+  dismiss_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Guard>
+inline Guard& sg::guard_vector<Guard>::operator[](std::size_t index) noexcept
+{
+  return m_data[index];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Guard>
+inline std::size_t sg::guard_vector<Guard>::size() const noexcept
+{
+  return m_size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Guard>
+inline std::size_t sg::guard_vector<Guard>::capacity() const noexcept
+{
+  return m_capacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Guard>
+void sg::guard_vector<Guard>::reallocate(std::size_t capacity)
+{
+  if(capacity > static_cast<std::size_t>(-1) / sizeof(Guard))
+    fail_allocation();
+
+  const auto bytes = capacity * sizeof(Guard);
+  if(relocates_bitwise) // the bytes are the guards: realloc copies them
+  {
+    const auto data = std::realloc(static_cast<void*>(m_data), bytes);
+    if(!data)
+      fail_allocation(); // m_data is still valid
+
+    m_data = static_cast<Guard*>(data);
+  }
+  else // move each guard, then destroy the original (inactive by now)
+  {
+    const auto data = static_cast<Guard*>(std::malloc(bytes));
+    if(!data)
+      fail_allocation();
+
+    for(auto i = std::size_t{0}; i < m_size; ++i)
+    {
+      ::new(static_cast<void*>(data + i)) Guard(std::move(m_data[i]));
+      m_data[i].~Guard();
+    }
+
+    std::free(m_data);
+    m_data = data;
+  }
+
+  m_capacity = capacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Guard>
+void sg::guard_vector<Guard>::fail_allocation()
+{
+#ifdef SG_NO_EXCEPTIONS
+  std::abort(); // as the standard containers do, without exceptions
+#else
+  throw std::bad_alloc{};
+#endif
+}
+
+#endif /* GUARD_VECTOR_HPP_ */
@@ -0,0 +1,182 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * Tests of the per-call-site counters of instrumented builds (C++20, with
+ * SG_INSTRUMENT defined by the build).
+ */
+
+#include "scope_guard.hpp"
+#include "latency_guard.hpp"
+#define SG_ENABLE_TRACE
+#include "trace_zone.hpp"
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main()
+#include "catch/catch.hpp"
+
+#include <cstdint>
+#include <source_location>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace sg;
+
+#ifndef SG_INSTRUMENT
+#error "these tests are meant to be built with SG_INSTRUMENT"
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  auto count = 0u;
+  void inc() noexcept { ++count; }
+  void reset() noexcept { count = 0u; }
+
+  struct incrementer
+  {
+    void inc() noexcept { ::inc(); }
+  };
+
+  // the counters of the site at the given line of this file (zero if none)
+  guard_site_counts counts_at(std::uint_least32_t line)
+  {
+    guard_site_counts found{};
+    for_each_guard_site([line, &found](const guard_site_counts& site)
+    {
+      if(site.file && site.line == line &&
+         std::string{site.file}.find("instrumented_tests.cpp") !=
+           std::string::npos)
+        found = site;
+    });
+    return found;
+  }
+
+  auto make_one_line = std::uint_least32_t{0};
+
+  // makes a guard, counted at the same site every time, and dismisses it
+  void make_one(bool dismiss_twice) noexcept
+  {
+    auto guard = make_scope_guard(inc);
+    make_one_line = std::source_location::current().line() - 1u;
+    guard.dismiss();
+    if(dismiss_twice)
+      guard.dismiss(); // not counted again
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("In instrumented builds, make_scope_guard counts the guards made, "
+          "fired and dismissed at each call site.")
+{
+  reset();
+  make_one(false);
+  make_one(true);
+  make_one(true);
+  REQUIRE(count == 0u);
+
+  const auto site = counts_at(make_one_line);
+  REQUIRE(site.created == 3u);
+  REQUIRE(site.dismissed == 3u);
+  REQUIRE(site.fired == 0u);
+  REQUIRE(site.moved_from == 0u);
+  REQUIRE(std::string{site.function}.find("make_one") != std::string::npos);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("In instrumented builds, guards that execute their callback count "
+          "as fired, and moves count the source as moved-from.")
+{
+  reset();
+  auto line = std::uint_least32_t{0};
+  for(auto i = 0; i < 4; ++i)
+  {
+    auto source = make_scope_guard([]() noexcept { inc(); });
+    line = std::source_location::current().line() - 1u;
+    if(i % 2)
+      const auto dest = std::move(source); // fires once, from dest
+  }
+  REQUIRE(count == 4u);
+
+  const auto site = counts_at(line);
+  REQUIRE(site.created == 4u);
+  REQUIRE(site.fired == 4u);
+  REQUIRE(site.dismissed == 0u);
+  REQUIRE(site.moved_from == 2u);
+  REQUIRE(site.column > 0u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("In instrumented builds, dump_guard_sites writes a line per site "
+          "with its counters.")
+{
+  {
+    const auto guard = make_scope_guard(inc);
+    const auto line = std::source_location::current().line() - 1u;
+    std::ostringstream out;
+    dump_guard_sites(out);
+
+    std::ostringstream expected;
+    expected << "instrumented_tests.cpp:" << line << ':';
+    const auto pos = out.str().find(expected.str());
+    REQUIRE(pos != std::string::npos);
+    REQUIRE(out.str().find(": created 1, fired 0, dismissed 0, moved-from 0\n",
+                           pos) != std::string::npos);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("In instrumented builds, scope guards keep their noexcept "
+          "specifications and their semantics otherwise.")
+{
+  static_assert(noexcept(make_scope_guard(inc)), "maker not noexcept");
+  static_assert(noexcept(make_scope_guard(inc).dismiss()),
+                "dismiss not noexcept");
+  reset();
+  {
+    const auto guard1 = make_scope_guard(inc);
+    auto guard2 = make_scope_guard(inc);
+    guard2.dismiss();
+  }
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("In instrumented builds, makers that build on make_scope_guard count "
+          "their guards where they are called, not in the library.")
+{
+  reset();
+  auto lines = std::vector<std::uint_least32_t>{};
+  {
+    const auto function_guard = make_scope_guard<&inc>();
+    lines.push_back(std::source_location::current().line() - 1u);
+
+    incrementer object;
+    const auto method_guard = make_scope_guard<&incrementer::inc>(object);
+    lines.push_back(std::source_location::current().line() - 1u);
+
+    static latency_site latency{"instrumented/latency"};
+    const auto latency_guard = make_latency_guard(latency);
+    lines.push_back(std::source_location::current().line() - 1u);
+
+    SG_TRACE_ZONE("instrumented/zone");
+    lines.push_back(std::source_location::current().line() - 1u);
+  }
+  REQUIRE(count == 2u);
+
+  for(const auto line : lines)
+  {
+    const auto site = counts_at(line);
+    REQUIRE(site.created == 1u);
+    REQUIRE(site.fired == 1u);
+  }
+
+  auto in_library = 0u;
+  for_each_guard_site([&in_library](const guard_site_counts& site)
+  {
+    if(site.file && std::string{site.file}.find(".hpp") != std::string::npos)
+      ++in_library;
+  });
+  REQUIRE(in_library == 0u);
+}
@@ -0,0 +1,528 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * See docs/interface.md for documentation of this header's public interface.
+ */
+
+#ifndef LATENCY_GUARD_HPP_
+#define LATENCY_GUARD_HPP_
+
+#include "scope_guard.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <ostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define SG_HAS_TSC
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define SG_HAS_TSC
+#endif
+
+#ifndef SG_LATENCY_MAX_SITES
+#define SG_LATENCY_MAX_SITES 256 // sites beyond this many are not recorded
+#endif
+
+namespace sg
+{
+  namespace detail
+  {
+    class shared_latency_histogram;
+  } // namespace detail
+
+
+  /* --- Tick sources --- */
+
+  struct steady_ticks final
+  {
+    typedef std::chrono::steady_clock::period period;
+    static std::uint64_t now() noexcept;
+  };
+
+#ifdef SG_HAS_TSC
+  struct tsc_ticks final
+  {
+    static std::uint64_t now() noexcept; // the time-stamp counter, unordered
+  };
+#endif
+
+
+  /* --- A log-linear histogram of tick counts --- */
+
+  class latency_histogram final
+  {
+  public:
+    static constexpr unsigned sub_bucket_bits = 3; /* each power of two is
+    split in 2^3 buckets, so buckets are at most 12.5% wide */
+    static constexpr std::size_t sub_bucket_count =
+      std::size_t{1} << sub_bucket_bits;
+    static constexpr std::size_t bucket_count =
+      (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+    static std::size_t bucket_index(std::uint64_t ticks) noexcept;
+    static std::uint64_t bucket_lower_bound(std::size_t index) noexcept;
+    static std::uint64_t bucket_upper_bound(std::size_t index) noexcept; /*
+    inclusive */
+
+    void record(std::uint64_t ticks) noexcept;
+    void merge(const latency_histogram& other) noexcept;
+
+    std::uint64_t bucket(std::size_t index) const noexcept; // its count
+    std::uint64_t count() const noexcept; // of recorded values
+    std::uint64_t quantile(double q) const noexcept; /* upper bound of the
+    bucket with the q-quantile, for q in [0, 1]; 0 when empty */
+
+  private:
+    friend class detail::shared_latency_histogram; // adds to m_buckets
+
+  private:
+    std::array<std::uint64_t, bucket_count> m_buckets{};
+
+  };
+
+
+  /* --- A static call-site, which latencies are recorded for --- */
+
+  class latency_site final
+  {
+  public:
+    explicit latency_site(const char* name) noexcept; /* registers the site;
+    name must outlive it (e.g. a string literal) */
+
+    const char* name() const noexcept;
+    unsigned id() const noexcept; // in registration order
+
+    latency_histogram histogram() const noexcept; // merged from all threads
+
+  public:
+    latency_site(const latency_site&) = delete;
+    latency_site(latency_site&&) = delete;
+    latency_site& operator=(const latency_site&) = delete;
+    latency_site& operator=(latency_site&&) = delete;
+
+  private:
+    friend void dump_latencies(std::ostream& out);
+
+  private:
+    const char* m_name;
+    unsigned m_id;
+    const latency_site* m_next; // in the registry, immutable once published
+
+  };
+
+  void dump_latencies(std::ostream& out); // one line per recorded site
+
+  namespace detail
+  {
+    std::size_t highest_bit(std::uint64_t value) noexcept; // value != 0
+
+    // A histogram with a single writer, the owning thread, and any readers
+    class shared_latency_histogram final
+    {
+    public:
+      void record(std::uint64_t ticks) noexcept; // by the owner only
+      void add_to(latency_histogram& histogram) const noexcept;
+
+    private:
+      std::array<std::atomic<std::uint64_t>,
+                 latency_histogram::bucket_count> m_buckets; /* zeroed by
+      value-initialization */
+
+    };
+
+    /* The histograms of a thread, per site id. Blocks are never freed: when
+    their thread exits, they are released, to be reused by another thread
+    with whatever they already recorded. */
+    struct latency_thread_block final
+    {
+      std::atomic<bool> m_in_use;
+      latency_thread_block* m_next; // immutable once published
+      std::array<std::atomic<shared_latency_histogram*>,
+                 SG_LATENCY_MAX_SITES> m_sites;
+    };
+
+    // Lock-free lists of sites and thread blocks, only ever pushed to
+    struct latency_registry final
+    {
+      constexpr latency_registry() noexcept
+        : m_sites{nullptr}, m_blocks{nullptr}, m_site_count{0u}
+      {}
+
+      std::atomic<const latency_site*> m_sites;
+      std::atomic<latency_thread_block*> m_blocks;
+      std::atomic<unsigned> m_site_count;
+    };
+
+    latency_registry& the_latency_registry() noexcept;
+
+    // This thread's block, if claimed, and whether the thread is exiting
+    struct latency_thread_state final
+    {
+      latency_thread_block* m_block;
+      bool m_exited;
+    };
+
+    latency_thread_state& this_thread_latency_state() noexcept;
+    latency_thread_block* claim_latency_block() noexcept; // for this thread
+    shared_latency_histogram* add_latency_histogram(latency_thread_block& block,
+                                                    unsigned site) noexcept;
+
+    void record_latency(unsigned site, std::uint64_t ticks) noexcept; /*
+    lock-free, and allocation-free once this thread recorded at this site */
+
+    // The callback of a latency guard: records the ticks since construction
+    template<typename Ticks>
+    class latency_recorder final
+    {
+    public:
+      explicit latency_recorder(const latency_site& site) noexcept;
+      void operator()() const noexcept;
+
+    private:
+      unsigned m_site;
+      std::uint64_t m_start;
+
+    };
+
+  } // namespace detail
+
+
+  /* --- The maker function --- */
+
+  template<typename Ticks = steady_ticks>
+  detail::scope_guard<detail::latency_recorder<Ticks>>
+  make_latency_guard(const latency_site& site
+#ifdef SG_INSTRUMENT
+    , std::source_location location = std::source_location::current()
+#endif
+  ) noexcept;
+
+} // namespace sg
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::uint64_t sg::steady_ticks::now() noexcept
+{
+  return static_cast<std::uint64_t>(
+    std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+#ifdef SG_HAS_TSC
+////////////////////////////////////////////////////////////////////////////////
+inline std::uint64_t sg::tsc_ticks::now() noexcept
+{
+  return static_cast<std::uint64_t>(__rdtsc());
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::size_t sg::detail::highest_bit(std::uint64_t value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return 63u - static_cast<std::size_t>(__builtin_clzll(value));
+#else
+  auto bit = std::size_t{0};
+  while(value >>= 1)
+    ++bit;
+  return bit;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::size_t
+sg::latency_histogram::bucket_index(std::uint64_t ticks) noexcept
+{
+  if(ticks < sub_bucket_count)
+    return static_cast<std::size_t>(ticks); // one bucket per value
+
+  const auto bit = detail::highest_bit(ticks);
+  const auto shift = bit - sub_bucket_bits;
+  return (shift + 1) * sub_bucket_count +
+         static_cast<std::size_t>((ticks >> shift) & (sub_bucket_count - 1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::uint64_t
+sg::latency_histogram::bucket_lower_bound(std::size_t index) noexcept
+{
+  if(index < sub_bucket_count)
+    return index;
+
+  const auto shift = index / sub_bucket_count - 1;
+  const auto sub = index % sub_bucket_count;
+  return static_cast<std::uint64_t>(sub_bucket_count + sub) << shift;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::uint64_t
+sg::latency_histogram::bucket_upper_bound(std::size_t index) noexcept
+{
+  if(index < sub_bucket_count)
+    return index;
+
+  const auto shift = index / sub_bucket_count - 1;
+  return bucket_lower_bound(index) + ((std::uint64_t{1} << shift) - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::latency_histogram::record(std::uint64_t ticks) noexcept
+{
+  ++m_buckets[bucket_index(ticks)];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void
+sg::latency_histogram::merge(const latency_histogram& other) noexcept
+{
+  for(auto i = std::size_t{0}; i < bucket_count; ++i)
+    m_buckets[i] += other.m_buckets[i];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::uint64_t
+sg::latency_histogram::bucket(std::size_t index) const noexcept
+{
+  return m_buckets[index];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::uint64_t sg::latency_histogram::count() const noexcept
+{
+  auto total = std::uint64_t{0};
+  for(const auto n : m_buckets)
+    total += n;
+  return total;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::uint64_t sg::latency_histogram::quantile(double q) const noexcept
+{
+  const auto total = count();
+  if(!total)
+    return 0;
+
+  auto rank = static_cast<std::uint64_t>(q * static_cast<double>(total));
+  if(static_cast<double>(rank) < q * static_cast<double>(total))
+    ++rank; // ceiling
+  if(rank < 1)
+    rank = 1;
+  else if(rank > total)
+    rank = total;
+
+  auto seen = std::uint64_t{0};
+  for(auto i = std::size_t{0}; i < bucket_count; ++i)
+    if((seen += m_buckets[i]) >= rank)
+      return bucket_upper_bound(i);
+
+  return 0; // unreachable
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::latency_site::latency_site(const char* name) noexcept
+  : m_name{name}
+  , m_id{detail::the_latency_registry().m_site_count.fetch_add(
+           1u, std::memory_order_relaxed)}
+  , m_next{nullptr}
+{
+  auto& sites = detail::the_latency_registry().m_sites;
+  m_next = sites.load(std::memory_order_relaxed);
+  while(!sites.compare_exchange_weak(m_next, this,
+                                     std::memory_order_release,
+                                     std::memory_order_relaxed))
+    ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline const char* sg::latency_site::name() const noexcept
+{
+  return m_name;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline unsigned sg::latency_site::id() const noexcept
+{
+  return m_id;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::latency_histogram sg::latency_site::histogram() const noexcept
+{
+  latency_histogram merged;
+  if(m_id >= SG_LATENCY_MAX_SITES)
+    return merged;
+
+  for(auto block =
+        detail::the_latency_registry().m_blocks.load(std::memory_order_acquire);
+      block;
+      block = block->m_next)
+    if(const auto histogram =
+         block->m_sites[m_id].load(std::memory_order_acquire))
+      histogram->add_to(merged);
+
+  return merged;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::dump_latencies(std::ostream& out)
+{
+  for(auto site =
+        detail::the_latency_registry().m_sites.load(std::memory_order_acquire);
+      site;
+      site = site->m_next)
+  {
+    const auto histogram = site->histogram();
+    if(const auto n = histogram.count())
+      out << site->name() << ": count " << n
+          << ", p50 " << histogram.quantile(0.5)
+          << ", p90 " << histogram.quantile(0.9)
+          << ", p99 " << histogram.quantile(0.99)
+          << ", max " << histogram.quantile(1.0) << " ticks\n";
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void
+sg::detail::shared_latency_histogram::record(std::uint64_t ticks) noexcept
+{
+  auto& bucket = m_buckets[latency_histogram::bucket_index(ticks)];
+  bucket.store(bucket.load(std::memory_order_relaxed) + 1,
+               std::memory_order_relaxed); // no other writer: no RMW needed
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::detail::shared_latency_histogram::add_to(
+  latency_histogram& histogram) const noexcept
+{
+  for(auto i = std::size_t{0}; i < latency_histogram::bucket_count; ++i)
+    histogram.m_buckets[i] += m_buckets[i].load(std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::detail::latency_registry& sg::detail::the_latency_registry() noexcept
+{
+  static latency_registry registry; // constant initialization, so no guard
+  return registry;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::detail::latency_thread_state&
+sg::detail::this_thread_latency_state() noexcept
+{
+  static thread_local latency_thread_state state = {nullptr, false}; /*
+  constant initialization, so no guard */
+  return state;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::detail::latency_thread_block*
+sg::detail::claim_latency_block() noexcept
+{
+  auto& registry = the_latency_registry();
+
+  auto block = registry.m_blocks.load(std::memory_order_acquire);
+  for(; block; block = block->m_next) // reuse one released by an exited thread
+    if(!block->m_in_use.load(std::memory_order_relaxed) &&
+       !block->m_in_use.exchange(true, std::memory_order_acquire))
+      break;
+
+  if(!block)
+  {
+    block = new(std::nothrow) latency_thread_block{}; // zeroed
+    if(!block)
+      return nullptr;
+
+    block->m_in_use.store(true, std::memory_order_relaxed);
+    block->m_next = registry.m_blocks.load(std::memory_order_relaxed);
+    while(!registry.m_blocks.compare_exchange_weak(block->m_next, block,
+                                                   std::memory_order_release,
+                                                   std::memory_order_relaxed))
+      ;
+  }
+
+  struct releaser
+  {
+    ~releaser()
+    {
+      auto& state = this_thread_latency_state();
+      if(state.m_block)
+        state.m_block->m_in_use.store(false, std::memory_order_release);
+      state = {nullptr, true}; // later records are dropped
+    }
+  };
+  static thread_local releaser release_at_thread_exit;
+  (void)release_at_thread_exit;
+
+  return block;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::detail::shared_latency_histogram*
+sg::detail::add_latency_histogram(latency_thread_block& block,
+                                  unsigned site) noexcept
+{
+  const auto histogram = new(std::nothrow) shared_latency_histogram{}; /*
+  zeroed */
+  if(histogram)
+    block.m_sites[site].store(histogram, std::memory_order_release);
+  return histogram;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::detail::record_latency(unsigned site,
+                                       std::uint64_t ticks) noexcept
+{
+  if(site >= SG_LATENCY_MAX_SITES)
+    return;
+
+  auto& state = this_thread_latency_state();
+  if(!state.m_block)
+  {
+    if(state.m_exited || !(state.m_block = claim_latency_block()))
+      return;
+  }
+
+  auto histogram = state.m_block->m_sites[site].load(std::memory_order_relaxed);
+  if(!histogram && !(histogram = add_latency_histogram(*state.m_block, site)))
+    return;
+
+  histogram->record(ticks);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Ticks>
+inline sg::detail::latency_recorder<Ticks>::latency_recorder(
+  const latency_site& site) noexcept
+  : m_site{site.id()}
+  , m_start{Ticks::now()}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Ticks>
+inline void sg::detail::latency_recorder<Ticks>::operator()() const noexcept
+{
+  record_latency(m_site, Ticks::now() - m_start);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Ticks>
+inline auto sg::make_latency_guard(const latency_site& site
+#ifdef SG_INSTRUMENT
+  , std::source_location location
+#endif
+) noexcept
+-> detail::scope_guard<detail::latency_recorder<Ticks>>
+{
+#ifdef SG_INSTRUMENT
+  return make_scope_guard(detail::latency_recorder<Ticks>{site}, location);
+#else
+  return make_scope_guard(detail::latency_recorder<Ticks>{site});
+#endif
+}
+
+#endif /* LATENCY_GUARD_HPP_ */
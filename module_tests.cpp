@@ -0,0 +1,105 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * Tests of the sg module (see scope_guard.cppm): the public interface is used
+ * through `import sg;`, without including scope_guard.hpp.
+ */
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main()
+#include "catch/catch.hpp"
+
+#include <utility>
+
+import sg;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  auto count = 0u;
+  void inc() noexcept { ++count; }
+
+  struct not_a_callback
+  {
+    int operator()() const noexcept { return 0; } // does not return void
+  };
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("An imported make_scope_guard calls back when leaving scope, unless "
+          "dismissed")
+{
+  count = 0u;
+  {
+    const auto guard = sg::make_scope_guard(inc);
+  }
+  REQUIRE(count == 1u);
+
+  {
+    auto guard = sg::make_scope_guard([]() noexcept { count += 10u; });
+    auto moved = std::move(guard);
+    moved.dismiss();
+  }
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Imported makers of multi-callback, flagless, token and status "
+          "guards call back as when included")
+{
+  count = 0u;
+  {
+    auto multi = sg::make_scope_guard(inc, inc, inc);
+    multi.dismiss<1>();
+    const auto exit = sg::make_scope_exit(inc);
+  }
+  REQUIRE(count == 3u);
+
+  sg::commit_token token;
+  {
+    const auto guard1 = sg::make_token_guard(token, inc);
+    const auto guard2 = sg::make_token_guard(token, inc);
+    token.commit();
+  }
+  REQUIRE(count == 3u);
+
+  {
+    auto status = 0;
+    const auto guard = sg::make_status_guard(status, inc);
+    status = -1;
+  }
+  REQUIRE(count == 4u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Imported failure and success makers call back depending on how "
+          "the scope is left")
+{
+  count = 0u;
+  {
+    const auto fail = sg::make_scope_fail([]() noexcept { count += 10u; });
+    const auto success = sg::make_scope_success(inc);
+  }
+  REQUIRE(count == 1u);
+
+  try
+  {
+    const auto fail = sg::make_scope_fail([]() noexcept { count += 10u; });
+    const auto success = sg::make_scope_success(inc);
+    throw 42;
+  }
+  catch(int) {}
+  REQUIRE(count == 11u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("The imported scope_guard_callback concept and traits discern "
+          "callbacks")
+{
+  static_assert(sg::scope_guard_callback<void(&)() noexcept>);
+  static_assert(!sg::scope_guard_callback<not_a_callback>);
+  static_assert(!sg::scope_guard_callback<int>);
+
+  static_assert(sg::is_scope_guard_callback<void(&)() noexcept>::value);
+  static_assert(!sg::is_scope_guard_callback_v<not_a_callback>);
+}
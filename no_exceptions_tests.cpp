@@ -0,0 +1,178 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * Tests of the interface that remains available without exceptions. They are
+ * built both with -fno-exceptions and without it, so that the sizes of the
+ * two binaries can be compared (see docs/tests.md).
+ */
+
+#include "scope_guard.hpp"
+#include "guard_vector.hpp"
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main()
+#include "catch/catch.hpp"
+
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+using namespace sg;
+
+#if defined(SG_EXPECT_NO_EXCEPTIONS) != defined(SG_NO_EXCEPTIONS)
+#error "SG_NO_EXCEPTIONS does not reflect whether exceptions are enabled"
+#endif
+
+#if defined(SG_NO_EXCEPTIONS) && defined(SG_HAS_UNCAUGHT_EXCEPTIONS)
+#error "failure and success guards should not be available without exceptions"
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  auto count = 0u;
+  void inc() noexcept { ++count; }
+  void reset() noexcept { count = 0u; }
+
+  // what an operation reports, in the style of many C APIs
+  enum class io_status { ok = 0, short_write, closed };
+
+  struct io_result
+  {
+    explicit operator bool() const noexcept { return status != io_status::ok; }
+    io_status status;
+  };
+
+  // a step that fails when asked to, reporting through ec
+  void step(bool fail, std::error_code& ec) noexcept
+  {
+    if(fail)
+      ec = std::make_error_code(std::errc::io_error);
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Without exceptions, a scope_guard executes its callback exactly "
+          "once when leaving scope, unless dismissed.")
+{
+  reset();
+  {
+    const auto guard = make_scope_guard(inc);
+    auto other = make_scope_guard([]() noexcept { inc(); });
+    const auto moved = std::move(other);
+  }
+  REQUIRE(count == 2u);
+
+  {
+    auto guard = make_scope_guard(inc);
+    guard.dismiss();
+  }
+  REQUIRE(count == 2u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Without exceptions, scope_exit and token guards work as with "
+          "exceptions.")
+{
+  reset();
+  {
+    const auto guard = make_scope_exit(inc);
+  }
+  REQUIRE(count == 1u);
+
+  {
+    commit_token token;
+    const auto guard1 = make_token_guard(token, inc);
+    const auto guard2 = make_token_guard(token, inc);
+    token.commit();
+  }
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A status guard rolls back when the std::error_code it observes "
+          "holds an error at the end of the scope.")
+{
+  reset();
+  for(auto fail_at = 0u; fail_at <= 3u; ++fail_at)
+  {
+    std::error_code ec;
+    const auto guard = make_status_guard(ec, inc);
+    for(auto i = 1u; i <= 2u && !ec; ++i)
+      step(fail_at == i, ec);
+  } // fails at 1 and at 2 roll back; 0 and 3 do not fail
+
+  REQUIRE(count == 2u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A status guard accepts integer error codes and types that convert "
+          "to bool explicitly, and only reads them when leaving scope.")
+{
+  reset();
+  {
+    auto rc = 0;
+    const auto guard = make_status_guard(rc, inc);
+    rc = -1;
+    rc = 0; // recovered
+  }
+  REQUIRE_FALSE(count);
+
+  {
+    auto rc = 0;
+    const auto guard = make_status_guard(rc, inc);
+    rc = 5;
+  }
+  REQUIRE(count == 1u);
+
+  {
+    io_result result{io_status::ok};
+    const auto guard = make_status_guard(result, inc);
+    result.status = io_status::closed;
+  }
+  REQUIRE(count == 2u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("A dismissed status guard does not roll back, and a moved status "
+          "guard rolls back once, from the destination.")
+{
+  reset();
+  {
+    auto rc = 1;
+    auto guard = make_status_guard(rc, inc);
+    guard.dismiss();
+  }
+  REQUIRE_FALSE(count);
+
+  {
+    auto rc = 1;
+    auto source = make_status_guard(rc, inc);
+    {
+      const auto dest = std::move(source);
+    }
+    REQUIRE(count == 1u);
+  }
+  REQUIRE(count == 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Without exceptions, a guard_vector grows and rolls back its guards "
+          "in reverse order.")
+{
+  auto order = 0u;
+  const auto record = [&order](unsigned digit) noexcept
+  {
+    return [&order, digit]() noexcept { order = order * 10u + digit; };
+  };
+
+  {
+    guard_vector<decltype(make_scope_guard(record(0u)))> guards;
+    for(auto i = 1u; i <= 20u; ++i) // beyond the initial capacity
+      guards.push_back(make_scope_guard(record(i % 10u)));
+    for(auto i = 0u; i < 16u; ++i)
+      guards[i].dismiss();
+  }
+
+  REQUIRE(order == 987u); // guards 20, 19, 18 and 17
+}
@@ -0,0 +1,210 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * See docs/interface.md for documentation of this header's public interface.
+ */
+
+#ifndef REUSABLE_SCOPE_GUARD_HPP_
+#define REUSABLE_SCOPE_GUARD_HPP_
+
+#include "any_scope_guard.hpp" // for the callback holder
+#include "scope_guard.hpp"
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sg
+{
+  // What a reusable guard does with its active callback, when it is replaced
+  enum class on_replace
+  {
+    fire, // executes it, as if the guard was destroyed
+    discard // destroys it without executing it, as if the guard was dismissed
+  };
+
+
+  /* --- A guard that can be default constructed, assigned and reset --- */
+
+  template<typename Callback, on_replace Policy = on_replace::fire>
+  class reusable_scope_guard;
+
+  template<on_replace Policy = on_replace::fire, typename Callback>
+  auto make_reusable_scope_guard(Callback&& callback)
+  noexcept(detail::is_nothrow_self_constructible_t<Callback>::value)
+  -> typename std::enable_if<detail::is_proper_sg_callback_t<Callback>::value,
+                             reusable_scope_guard<Callback, Policy>>::type;
+
+  template<typename Callback, on_replace Policy>
+  class reusable_scope_guard final
+  {
+  public:
+    static_assert(detail::is_proper_sg_callback_t<Callback>::value &&
+                  !std::is_rvalue_reference<Callback>::value,
+                  "improper callback type for reusable_scope_guard (consider "
+                  "deducing it with make_reusable_scope_guard)");
+
+    typedef Callback callback_type;
+
+    reusable_scope_guard() noexcept; // inactive, without a callback
+
+    reusable_scope_guard(reusable_scope_guard&& other)
+    noexcept(detail::is_nothrow_self_constructible_t<Callback>::value);
+
+    reusable_scope_guard& operator=(reusable_scope_guard&& other)
+    noexcept(detail::is_nothrow_self_constructible_t<Callback>::value); /*
+    first fires or discards the current callback, if active, per Policy */
+
+    ~reusable_scope_guard() noexcept; // calls back, if active
+
+    void reset(Callback&& callback)
+    noexcept(detail::is_nothrow_self_constructible_t<Callback>::value); /*
+    idem, then takes callback, as active */
+
+    void dismiss() noexcept; // also destroys the callback
+
+  public:
+    reusable_scope_guard(const reusable_scope_guard&) = delete;
+    reusable_scope_guard& operator=(const reusable_scope_guard&) = delete;
+
+  private:
+    explicit reusable_scope_guard(Callback&& callback)
+    noexcept(detail::is_nothrow_self_constructible_t<Callback>::value); /*
+                                                      meant for friends only */
+
+    template<on_replace P, typename C>
+    friend auto make_reusable_scope_guard(C&& callback)
+    noexcept(detail::is_nothrow_self_constructible_t<C>::value)
+    -> typename std::enable_if<detail::is_proper_sg_callback_t<C>::value,
+                               reusable_scope_guard<C, P>>::type;
+
+    void replace() noexcept; // fires or discards per Policy, if active
+    void take(Callback&& callback)
+    noexcept(detail::is_nothrow_self_constructible_t<Callback>::value); /*
+    when inactive */
+
+  private:
+    union
+    {
+      detail::callback_holder<Callback> m_holder; // only alive when active
+    };
+    bool m_active;
+
+  };
+
+} // namespace sg
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Callback, sg::on_replace Policy>
+sg::reusable_scope_guard<Callback, Policy>::reusable_scope_guard() noexcept
+  : m_active{false}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Callback, sg::on_replace Policy>
+sg::reusable_scope_guard<Callback, Policy>::reusable_scope_guard(
+  Callback&& callback)
+noexcept(detail::is_nothrow_self_constructible_t<Callback>::value)
+  : m_active{false}
+{
+  take(std::forward<Callback>(callback));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Callback, sg::on_replace Policy>
+sg::reusable_scope_guard<Callback, Policy>::reusable_scope_guard(
+  reusable_scope_guard&& other)
+noexcept(detail::is_nothrow_self_constructible_t<Callback>::value)
+  : m_active{false}
+{
+  if(other.m_active)
+  {
+    take(std::forward<Callback>(other.m_holder.m_callback));
+    other.dismiss();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Callback, sg::on_replace Policy>
+auto sg::reusable_scope_guard<Callback, Policy>::operator=(
+  reusable_scope_guard&& other)
+noexcept(detail::is_nothrow_self_constructible_t<Callback>::value)
+-> reusable_scope_guard&
+{
+  if(this != &other)
+  {
+    replace();
+    if(other.m_active)
+    {
+      take(std::forward<Callback>(other.m_holder.m_callback));
+      other.dismiss();
+    }
+  }
+
+  return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Callback, sg::on_replace Policy>
+sg::reusable_scope_guard<Callback, Policy>::~reusable_scope_guard() noexcept
+{
+  if(m_active)
+  {
+    m_holder.m_callback();
+    dismiss();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Callback, sg::on_replace Policy>
+void sg::reusable_scope_guard<Callback, Policy>::reset(Callback&& callback)
+noexcept(detail::is_nothrow_self_constructible_t<Callback>::value)
+{
+  replace();
+  take(std::forward<Callback>(callback));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Callback, sg::on_replace Policy>
+inline void sg::reusable_scope_guard<Callback, Policy>::dismiss() noexcept
+{
+  if(m_active)
+  {
+    m_holder.~callback_holder();
+    m_active = false;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Callback, sg::on_replace Policy>
+inline void sg::reusable_scope_guard<Callback, Policy>::replace() noexcept
+{
+  if(Policy == on_replace::fire && m_active)
+    m_holder.m_callback();
+  dismiss();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Callback, sg::on_replace Policy>
+inline void sg::reusable_scope_guard<Callback, Policy>::take(
+  Callback&& callback)
+noexcept(detail::is_nothrow_self_constructible_t<Callback>::value)
+{
+  ::new(static_cast<void*>(&m_holder))
+    detail::callback_holder<Callback>(std::forward<Callback>(callback));
+  m_active = true; // only once constructed
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<sg::on_replace Policy, typename Callback>
+inline auto sg::make_reusable_scope_guard(Callback&& callback)
+noexcept(detail::is_nothrow_self_constructible_t<Callback>::value)
+-> typename std::enable_if<detail::is_proper_sg_callback_t<Callback>::value,
+                           reusable_scope_guard<Callback, Policy>>::type
+{
+  return reusable_scope_guard<Callback, Policy>{
+    std::forward<Callback>(callback)};
+}
+
+#endif /* REUSABLE_SCOPE_GUARD_HPP_ */
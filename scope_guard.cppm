@@ -0,0 +1,38 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * The module interface unit of the sg module (C++20), which exports the public
+ * interface of scope_guard.hpp. Clients can then `import sg;` instead of
+ * including the header. See docs/interface.md for documentation.
+ *
+ * Compilation options (e.g. SG_REQUIRE_NOEXCEPT_IN_CPP17) apply where the
+ * module is built, not where it is imported. SG_UNCAUGHT_EXCEPTIONS_FROM_CXXABI
+ * is not supported (its thread-local cache fails to link in importers), nor is
+ * SG_INSTRUMENT (whose standard headers are not in the global fragment). The
+ * other headers in this library are not part of the module, and they include
+ * scope_guard.hpp, so they should not be used in translation units that import
+ * sg.
+ */
+
+module;
+
+// standard headers go in the global module fragment, so that they are not
+// attached to sg (including them again from scope_guard.hpp is then a no-op)
+#include <cstddef>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+#if defined(SG_UNCAUGHT_EXCEPTIONS_FROM_CXXABI)
+#error "SG_UNCAUGHT_EXCEPTIONS_FROM_CXXABI is not supported in the sg module"
+#endif
+
+#if defined(SG_INSTRUMENT)
+#error "SG_INSTRUMENT is not supported in the sg module"
+#endif
+
+export module sg;
+
+#define SG_EXPORT export
+#include "scope_guard.hpp"
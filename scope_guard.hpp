@@ -8,6 +8,8 @@
 #ifndef SCOPE_GUARD_HPP_
 #define SCOPE_GUARD_HPP_
 
+#include <cstddef>
+#include <exception>
 #include <type_traits>
 #include <utility>
 
@@ -15,6 +17,59 @@
 #define SG_REQUIRE_NOEXCEPT
 #endif
 
+#if !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && \
+    !defined(_CPPUNWIND)
+#define SG_NO_EXCEPTIONS // e.g. with -fno-exceptions
+#endif
+
+#if defined(SG_NO_EXCEPTIONS)
+// nothing to count: no scope_fail or scope_success (see make_status_guard)
+#elif defined(SG_UNCAUGHT_EXCEPTIONS_FROM_CXXABI)
+#include <cxxabi.h>
+#define SG_HAS_UNCAUGHT_EXCEPTIONS
+#elif defined(__cpp_lib_uncaught_exceptions)
+#define SG_HAS_UNCAUGHT_EXCEPTIONS
+#endif
+
+#ifndef SG_EXPORT
+#define SG_EXPORT // export, when building the sg module (see scope_guard.cppm)
+#endif
+
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+#define SG_HAS_CONCEPTS
+#define SG_CALLBACK_TYPENAME ::sg::scope_guard_callback // constrained parameter
+#else
+#define SG_CALLBACK_TYPENAME typename
+#endif
+
+#if defined(__has_builtin) // e.g. clang, where trivial_abi types qualify
+#if __has_builtin(__builtin_is_cpp_trivially_relocatable)
+#define SG_IS_TRIVIALLY_RELOCATABLE(T) __builtin_is_cpp_trivially_relocatable(T)
+#elif __has_builtin(__is_trivially_relocatable)
+#define SG_IS_TRIVIALLY_RELOCATABLE(T) __is_trivially_relocatable(T)
+#endif
+#endif
+
+#if __cplusplus >= 202002L && defined(__has_cpp_attribute) && !defined(_MSC_VER)
+#if __has_cpp_attribute(no_unique_address)
+#define SG_NO_UNIQUE_ADDRESS
+#endif
+#endif
+
+#ifdef SG_INSTRUMENT // per-site counters of what guards do (see docs)
+#if __cplusplus < 202002L
+#error "SG_INSTRUMENT requires C++20, for std::source_location"
+#endif
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <source_location>
+#ifndef SG_INSTRUMENT_MAX_SITES
+#define SG_INSTRUMENT_MAX_SITES 1024 // later sites share a single entry
+#endif
+#endif
+
 namespace sg
 {
   namespace detail
@@ -53,6 +108,70 @@ namespace sg
 #endif
     {};
 
+    // Type trait determining whether an object type is nothrow destructible
+    template<typename T, typename = void>
+    struct is_nothrow_object_destructible_t
+      : public std::false_type
+    {}; // in general, false
+
+    template<typename T>
+    struct is_nothrow_object_destructible_t<
+      T, typename std::enable_if<noexcept(std::declval<T&>().~T())>::type>
+      : public std::true_type
+    {}; // only true when destructor valid and nothrow
+
+    /* Type trait determining whether a type is nothrow destructible (much
+    cheaper to instantiate than std::is_nothrow_destructible, and equivalent
+    for callbacks, which are neither arrays nor void) */
+    template<typename T>
+    struct is_nothrow_destructible_t
+      : public std::conditional<std::is_reference<T>::value,
+                                std::true_type,
+                                is_nothrow_object_destructible_t<T>>::type
+    {}; // references are trivially destructible
+
+    /* Type trait determining whether a type is constructible from an rvalue of
+    itself, i.e. movable or copyable if not a reference (cheaper to instantiate
+    than std::is_constructible<T, T&&>) */
+    template<typename T, typename = void>
+    struct is_self_constructible_t
+      : public std::false_type
+    {}; // in general, false
+
+    template<typename T>
+    struct is_self_constructible_t<T, decltype(T(std::declval<T&&>()), void())>
+      : public std::true_type
+    {}; // only true when construction valid
+
+    /* Type trait determining whether a type is nothrow constructible from an
+    rvalue of itself (much cheaper to instantiate than
+    std::is_nothrow_constructible<T, T&&>) */
+    template<typename T, typename = void>
+    struct is_nothrow_self_constructible_t
+      : public std::false_type
+    {}; // in general, false
+
+    template<typename T>
+    struct is_nothrow_self_constructible_t<
+      T, typename std::enable_if<noexcept(T(std::declval<T&&>()))>::type>
+      : public std::true_type
+    {}; // only true when construction valid and nothrow
+
+    /* Type trait determining whether a type can be observed as an error
+    status, i.e. whether it converts to bool (true meaning error) without
+    throwing, like std::error_code or an int error code */
+    template<typename T, typename = void>
+    struct is_error_status_t
+      : public std::false_type
+    {}; // in general, false
+
+    template<typename T>
+    struct is_error_status_t<
+      T, typename std::enable_if<
+           noexcept(static_cast<bool>(std::declval<const T&>()))>::type>
+      : public std::true_type
+    {}; // only true when conversion valid and nothrow
+
     // logic AND of two or more type traits
     template<typename A, typename B, typename... C>
     struct and_t : public and_t<A, and_t<B, C...>>
@@ -62,29 +181,142 @@ namespace sg
     struct and_t<A, B> : public std::conditional<A::value, B, A>::type
     {}; // for two arguments
 
+  } // namespace detail
+
+
+#ifdef SG_HAS_CONCEPTS
+  /* --- The requirements on callbacks, as a concept (C++20) --- */
+
+  SG_EXPORT template<typename T>
+  concept scope_guard_callback =
+    std::is_void_v<decltype(std::declval<T&&>()())> && // no-arg, returns void
+#ifdef SG_REQUIRE_NOEXCEPT
+    noexcept(std::declval<T&&>()()) &&
+#endif
+    detail::is_nothrow_destructible_t<T>::value &&
+    detail::is_self_constructible_t<T>::value; // storable in a guard
+#endif
+
+
+  namespace detail
+  {
     // Type trait determining whether a type is a proper scope_guard callback.
     template<typename T>
     struct is_proper_sg_callback_t
+#ifdef SG_HAS_CONCEPTS
+      : public std::bool_constant<scope_guard_callback<T>>
+#else
       : public and_t<is_noarg_callable_t<T>,
                      returns_void_t<T>,
                      is_nothrow_invocable_if_required_t<T>,
-                     std::is_nothrow_destructible<T>>
+                     is_nothrow_destructible_t<T>,
+                     is_self_constructible_t<T>>
+#endif
+    {};
+
+#ifndef SG_NO_UNIQUE_ADDRESS
+    /* Type trait determining whether a callback type can be stored as an empty
+    base, taking no space (cv-qualified types are excluded, to preserve the
+    qualification with which the callback is called) */
+    template<typename T>
+    struct is_empty_base_candidate_t
+      : public std::integral_constant<bool,
+                                      std::is_empty<T>::value &&
+                                      !std::is_const<T>::value &&
+                                      !std::is_volatile<T>::value &&
+#if __cplusplus >= 201402L
+                                      !std::is_final<T>::value
+#else
+                                      !__is_final(T) // std::is_final is C++14
+#endif
+                                      >
     {};
+#endif
+
+
+    /* --- Callback storage, taking no space for empty callbacks --- */
+
+    template<typename Callback,
+             std::size_t Index = 0, /* distinguishes callbacks stored together
+                                       (possibly with the same type) */
+             typename = void>
+    class callback_storage
+    {
+    protected:
+      explicit callback_storage(Callback&& callback)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value);
+
+      Callback& callback() noexcept;
+
+    private:
+#ifdef SG_NO_UNIQUE_ADDRESS
+      [[no_unique_address]]
+#endif
+      Callback m_callback;
+    };
+
+#ifndef SG_NO_UNIQUE_ADDRESS
+    template<typename Callback, std::size_t Index>
+    class callback_storage<Callback, Index, typename std::enable_if<
+                             is_empty_base_candidate_t<Callback>::value>::type>
+      : private Callback // empty base optimization
+    {
+    protected:
+      explicit callback_storage(Callback&& callback)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value);
+
+      Callback& callback() noexcept;
+    };
+#endif
+
+
+#ifdef SG_INSTRUMENT
+    /* --- Per-call-site counters, in instrumented builds --- */
+
+    /* The counters of a call site of make_scope_guard, in a fixed table with
+    static storage. The key is written once, while the entry is claimed. */
+    struct guard_site
+    {
+      enum : unsigned char { empty, claimed, ready };
+
+      std::atomic<unsigned char> m_state{empty};
+      const char* m_file = nullptr; // null for the entry of later sites
+      const char* m_function = nullptr;
+      std::uint_least32_t m_line = 0;
+      std::uint_least32_t m_column = 0;
+      std::atomic<std::uint64_t> m_created{0u};
+      std::atomic<std::uint64_t> m_fired{0u};
+      std::atomic<std::uint64_t> m_dismissed{0u};
+      std::atomic<std::uint64_t> m_moved_from{0u};
+    };
+
+    guard_site* guard_sites() noexcept; /* SG_INSTRUMENT_MAX_SITES entries,
+    then one for any later sites */
+    guard_site& find_guard_site(const std::source_location& location) noexcept;
+#endif
 
 
     /* --- The actual scope_guard template --- */
 
+#ifdef SG_HAS_CONCEPTS
+    template<scope_guard_callback Callback, typename = void>
+#else
     template<typename Callback,
              typename = typename std::enable_if<
                is_proper_sg_callback_t<Callback>::value>::type>
+#endif
     class scope_guard;
 
 
     /* --- Now the friend maker --- */
 
-    template<typename Callback>
-    detail::scope_guard<Callback> make_scope_guard(Callback&& callback)
-    noexcept(std::is_nothrow_constructible<Callback, Callback&&>::value); /*
+    template<SG_CALLBACK_TYPENAME Callback>
+    detail::scope_guard<Callback> make_scope_guard(Callback&& callback
+#ifdef SG_INSTRUMENT
+      , std::source_location location = std::source_location::current()
+#endif
+    )
+    noexcept(is_nothrow_self_constructible_t<Callback>::value); /*
     we need this in the inner namespace due to MSVC bugs preventing
     sg::detail::scope_guard from befriending a sg::make_scope_guard
     template instance in the parent namespace (see https://is.gd/xFfFhE). */
@@ -92,14 +324,14 @@ namespace sg
 
     /* --- The template specialization that actually defines the class --- */
 
-    template<typename Callback>
-    class scope_guard<Callback> final
+    template<SG_CALLBACK_TYPENAME Callback>
+    class scope_guard<Callback> final : private callback_storage<Callback>
     {
     public:
       typedef Callback callback_type;
 
       scope_guard(scope_guard&& other)
-      noexcept(std::is_nothrow_constructible<Callback, Callback&&>::value);
+      noexcept(is_nothrow_self_constructible_t<Callback>::value);
 
       ~scope_guard() noexcept; // highlight noexcept dtor
 
@@ -112,73 +344,1135 @@ namespace sg
       scope_guard& operator=(scope_guard&&) = delete;
 
     private:
+#ifdef SG_INSTRUMENT
+      scope_guard(Callback&& callback, guard_site& site)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value); /*
+                                                      meant for friends only */
+
+      friend scope_guard<Callback>
+      make_scope_guard<Callback>(Callback&&, std::source_location)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value); // idem
+#else
       explicit scope_guard(Callback&& callback)
-      noexcept(std::is_nothrow_constructible<Callback, Callback&&>::value); /*
+      noexcept(is_nothrow_self_constructible_t<Callback>::value); /*
                                                       meant for friends only */
 
       friend scope_guard<Callback> make_scope_guard<Callback>(Callback&&)
-      noexcept(std::is_nothrow_constructible<Callback, Callback&&>::value); /*
+      noexcept(is_nothrow_self_constructible_t<Callback>::value); /*
       only make_scope_guard can create scope_guards from scratch (i.e. non-move)
       */
+#endif
 
     private:
-      Callback m_callback;
       bool m_active;
+#ifdef SG_INSTRUMENT
+      guard_site* m_site; // where the guard was made
+#endif
 
     };
 
-  } // namespace detail
 
+    /* --- A flagless variant, for guards that are never dismissed --- */
 
-  /* --- Now the single public maker function --- */
+#ifdef SG_HAS_CONCEPTS
+    template<scope_guard_callback Callback, typename = void>
+#else
+    template<typename Callback,
+             typename = typename std::enable_if<
+               is_proper_sg_callback_t<Callback>::value>::type>
+#endif
+    class scope_exit;
 
-  using detail::make_scope_guard; // see comment on declaration above
+    template<SG_CALLBACK_TYPENAME Callback>
+    detail::scope_exit<Callback> make_scope_exit(Callback&& callback)
+    noexcept(is_nothrow_self_constructible_t<Callback>::value); /*
+    in the inner namespace for the same reason as make_scope_guard */
 
-} // namespace sg
+    template<SG_CALLBACK_TYPENAME Callback>
+    class scope_exit<Callback> final : private callback_storage<Callback>
+    {
+    public:
+      typedef Callback callback_type;
 
-////////////////////////////////////////////////////////////////////////////////
-template<typename Callback>
-sg::detail::scope_guard<Callback>::scope_guard(Callback&& callback)
-noexcept(std::is_nothrow_constructible<Callback, Callback&&>::value)
-  : m_callback(std::forward<Callback>(callback)) /* use () instead of {} because
-    of DR 1467 (https://is.gd/WHmWuo), which still impacts older compilers
-    (e.g. GCC 4.x and clang <=3.6, see https://godbolt.org/g/TE9tPJ and
-    https://is.gd/Tsmh8G) */
-  , m_active{true}
-{}
+      ~scope_exit() noexcept; // unconditionally calls back
 
-////////////////////////////////////////////////////////////////////////////////
-template<typename Callback>
-sg::detail::scope_guard<Callback>::~scope_guard() noexcept
-{
-  if(m_active)
-    m_callback();
-}
+    public:
+      scope_exit() = delete;
+      scope_exit(const scope_exit&) = delete;
+      scope_exit& operator=(const scope_exit&) = delete;
+      scope_exit& operator=(scope_exit&&) = delete;
 
-////////////////////////////////////////////////////////////////////////////////
-template<typename Callback>
-sg::detail::scope_guard<Callback>::scope_guard(scope_guard&& other)
-noexcept(std::is_nothrow_constructible<Callback, Callback&&>::value)
-  : m_callback(std::forward<Callback>(other.m_callback)) // idem
-  , m_active{std::move(other.m_active)}
-{
-  other.m_active = false;
-}
+#if __cplusplus >= 201703L
+      scope_exit(scope_exit&&) = delete; /* without a flag, a moved-from guard
+      would still call back; guaranteed copy elision makes this unnecessary */
+#else
+      scope_exit(scope_exit&&) noexcept; /* declared, but never defined: needed
+      only to copy-initialize from make_scope_exit, where it is always elided
+      (using it otherwise fails at link time) */
+#endif
 
-////////////////////////////////////////////////////////////////////////////////
-template<typename Callback>
-inline void sg::detail::scope_guard<Callback>::dismiss() noexcept
-{
-  m_active = false;
-}
+    private:
+      explicit scope_exit(Callback&& callback)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value); /*
+                                                      meant for friends only */
 
-////////////////////////////////////////////////////////////////////////////////
-template<typename Callback>
-inline auto sg::detail::make_scope_guard(Callback&& callback)
-noexcept(std::is_nothrow_constructible<Callback, Callback&&>::value)
--> detail::scope_guard<Callback>
-{
-  return detail::scope_guard<Callback>{std::forward<Callback>(callback)};
-}
+      friend scope_exit<Callback> make_scope_exit<Callback>(Callback&&)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value);
+
+    };
+
+
+    /* --- A guard that fuses several callbacks, with a single activity mask */
+
+    // A sequence of indices (std::index_sequence is C++14)
+    template<std::size_t... Is>
+    struct index_sequence
+    {};
+
+    template<std::size_t N, std::size_t... Is>
+    struct make_index_sequence_t
+      : public make_index_sequence_t<N - 1, N - 1, Is...>
+    {}; // prepends indices, counting down
+
+    template<std::size_t... Is>
+    struct make_index_sequence_t<0, Is...>
+    {
+      typedef index_sequence<Is...> type;
+    }; // done
+
+    // Type trait obtaining the type at the specified index of a type list
+    template<std::size_t I, typename T, typename... Ts>
+    struct type_at_t : public type_at_t<I - 1, Ts...>
+    {}; // skips one type
+
+    template<typename T, typename... Ts>
+    struct type_at_t<0, T, Ts...>
+    {
+      typedef T type;
+    }; // found
+
+    // Type trait determining whether all types are proper scope_guard callbacks
+    template<typename... Ts>
+    struct are_proper_sg_callbacks_t
+      : public std::true_type
+    {}; // for no types
+
+    template<typename T, typename... Ts>
+    struct are_proper_sg_callbacks_t<T, Ts...>
+      : public and_t<is_proper_sg_callback_t<T>,
+                     are_proper_sg_callbacks_t<Ts...>>
+    {}; // for one or more types
+
+    /* Type trait determining whether all types can be nothrow constructed from
+    rvalues of themselves */
+    template<typename... Ts>
+    struct are_nothrow_self_constructible_t
+      : public std::true_type
+    {}; // for no types
+
+    template<typename T, typename... Ts>
+    struct are_nothrow_self_constructible_t<T, Ts...>
+      : public and_t<is_nothrow_self_constructible_t<T>,
+                     are_nothrow_self_constructible_t<Ts...>>
+    {}; // for one or more types
+
+    // Type trait obtaining the smallest unsigned type with at least N bits
+    template<std::size_t N>
+    struct mask_for_t
+      : public std::conditional<
+          N <= 8, unsigned char, typename std::conditional<
+            N <= 16, unsigned short, typename std::conditional<
+              N <= 32, unsigned int, unsigned long long>::type>::type>
+    {
+      static_assert(N <= 64, "too many callbacks for a single scope_guard");
+    };
+
+    template<typename Indices, typename... Callbacks>
+    class multi_scope_guard; // only defined for index_sequence, see below
+
+    template<typename... Callbacks>
+    using multi_scope_guard_t = multi_scope_guard<
+      typename make_index_sequence_t<sizeof...(Callbacks)>::type, Callbacks...>;
+
+    template<SG_CALLBACK_TYPENAME Callback1,
+             SG_CALLBACK_TYPENAME Callback2,
+             SG_CALLBACK_TYPENAME... Callbacks>
+    auto make_scope_guard(Callback1&& callback1,
+                          Callback2&& callback2,
+                          Callbacks&&... callbacks)
+    noexcept(are_nothrow_self_constructible_t<Callback1,
+                                              Callback2,
+                                              Callbacks...>::value)
+    -> typename std::enable_if<
+         are_proper_sg_callbacks_t<Callback1, Callback2, Callbacks...>::value,
+         multi_scope_guard_t<Callback1, Callback2, Callbacks...>>::type; /*
+    in the inner namespace for the same reason as the single callback version */
+
+    template<std::size_t... Indices, typename... Callbacks>
+    class multi_scope_guard<index_sequence<Indices...>, Callbacks...> final
+      : private callback_storage<Callbacks, Indices>...
+    {
+    public:
+      template<std::size_t Index>
+      using callback_type = typename type_at_t<Index, Callbacks...>::type;
+
+      multi_scope_guard(multi_scope_guard&& other)
+      noexcept(are_nothrow_self_constructible_t<Callbacks...>::value);
+
+      ~multi_scope_guard() noexcept; // calls back in reverse order
+
+      void dismiss() noexcept; // dismisses all callbacks
+
+      template<std::size_t Index>
+      void dismiss() noexcept; // dismisses only the callback at Index
+
+    public:
+      multi_scope_guard() = delete;
+      multi_scope_guard(const multi_scope_guard&) = delete;
+      multi_scope_guard& operator=(const multi_scope_guard&) = delete;
+      multi_scope_guard& operator=(multi_scope_guard&&) = delete;
+
+    private:
+      typedef typename mask_for_t<sizeof...(Callbacks)>::type mask_type;
+
+      explicit multi_scope_guard(Callbacks&&... callbacks)
+      noexcept(are_nothrow_self_constructible_t<Callbacks...>::value); /*
+                                                      meant for friends only */
+
+      friend multi_scope_guard make_scope_guard<Callbacks...>(Callbacks&&...)
+      noexcept(are_nothrow_self_constructible_t<Callbacks...>::value);
+
+      template<std::size_t Index>
+      void call_back_if_active() noexcept;
+
+    private:
+      mask_type m_active; // one bit per callback
+
+    };
+
+
+    /* --- Guards that share a commit token, instead of owning a flag --- */
+
+    // A flag that commits (i.e. dismisses) many guards with a single store
+    class commit_token final
+    {
+    public:
+      commit_token() noexcept;
+
+      void commit() noexcept;
+      bool is_committed() const noexcept;
+
+    public:
+      commit_token(const commit_token&) = delete;
+      commit_token(commit_token&&) = delete; // guards refer to it
+      commit_token& operator=(const commit_token&) = delete;
+      commit_token& operator=(commit_token&&) = delete;
+
+    private:
+      bool m_committed;
+
+    };
+
+#ifdef SG_HAS_CONCEPTS
+    template<scope_guard_callback Callback, typename = void>
+#else
+    template<typename Callback,
+             typename = typename std::enable_if<
+               is_proper_sg_callback_t<Callback>::value>::type>
+#endif
+    class token_scope_guard;
+
+    template<SG_CALLBACK_TYPENAME Callback>
+    detail::token_scope_guard<Callback>
+    make_token_guard(const commit_token& token, Callback&& callback)
+    noexcept(is_nothrow_self_constructible_t<Callback>::value); /*
+    in the inner namespace for the same reason as make_scope_guard */
+
+    template<typename Callback>
+    void make_token_guard(const commit_token&&, Callback&&) = delete; /* the
+    guard would outlive a temporary token */
+
+    template<SG_CALLBACK_TYPENAME Callback>
+    class token_scope_guard<Callback> final : private callback_storage<Callback>
+    {
+    public:
+      typedef Callback callback_type;
+
+      token_scope_guard(token_scope_guard&& other)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value);
+
+      ~token_scope_guard() noexcept; // calls back unless dismissed or committed
+
+      void dismiss() noexcept; // only this guard
+
+    public:
+      token_scope_guard() = delete;
+      token_scope_guard(const token_scope_guard&) = delete;
+      token_scope_guard& operator=(const token_scope_guard&) = delete;
+      token_scope_guard& operator=(token_scope_guard&&) = delete;
+
+    private:
+      token_scope_guard(const commit_token& token, Callback&& callback)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value); /*
+                                                      meant for friends only */
+
+      friend token_scope_guard<Callback>
+      make_token_guard<Callback>(const commit_token&, Callback&&)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value);
+
+    private:
+      const commit_token* m_token; // null when dismissed
+
+    };
+
+
+    /* --- Guards that observe an error status, instead of exceptions --- */
+
+#ifdef SG_HAS_CONCEPTS
+    template<typename Status,
+             scope_guard_callback Callback,
+             typename = typename std::enable_if<
+               is_error_status_t<Status>::value>::type>
+#else
+    template<typename Status,
+             typename Callback,
+             typename = typename std::enable_if<
+               is_error_status_t<Status>::value &&
+               is_proper_sg_callback_t<Callback>::value>::type>
+#endif
+    class status_scope_guard;
+
+    template<typename Status, SG_CALLBACK_TYPENAME Callback>
+    detail::status_scope_guard<Status, Callback>
+    make_status_guard(const Status& status, Callback&& callback)
+    noexcept(is_nothrow_self_constructible_t<Callback>::value); /*
+    in the inner namespace for the same reason as make_scope_guard */
+
+    template<typename Status, typename Callback>
+    void make_status_guard(const Status&&, Callback&&) = delete; /* the guard
+    would outlive a temporary status */
+
+    template<typename Status, SG_CALLBACK_TYPENAME Callback>
+    class status_scope_guard<Status, Callback> final
+      : private callback_storage<Callback>
+    {
+    public:
+      typedef Callback callback_type;
+
+      status_scope_guard(status_scope_guard&& other)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value);
+
+      ~status_scope_guard() noexcept; /* calls back if not dismissed and the
+      status holds an error */
+
+      void dismiss() noexcept;
+
+    public:
+      status_scope_guard() = delete;
+      status_scope_guard(const status_scope_guard&) = delete;
+      status_scope_guard& operator=(const status_scope_guard&) = delete;
+      status_scope_guard& operator=(status_scope_guard&&) = delete;
+
+    private:
+      status_scope_guard(const Status& status, Callback&& callback)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value); /*
+                                                      meant for friends only */
+
+      friend status_scope_guard<Status, Callback>
+      make_status_guard<Status, Callback>(const Status&, Callback&&)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value);
+
+    private:
+      const Status* m_status; // null when dismissed
+
+    };
+
+
+#ifdef SG_HAS_UNCAUGHT_EXCEPTIONS
+    /* --- Variants that only call back on failure, or only on success --- */
+
+#ifdef SG_UNCAUGHT_EXCEPTIONS_FROM_CXXABI
+    // The start of the Itanium C++ ABI's per-thread exception globals
+    struct cxa_eh_globals_prefix
+    {
+      void* m_caught_exceptions;
+      unsigned int m_uncaught_exceptions;
+    };
+
+    /* Counts uncaught exceptions by reading the runtime's thread-local counter,
+    whose address is cached in a thread-local pointer (no library call after
+    the first time in each thread) */
+    struct cxxabi_exception_counter
+    {
+      static int count() noexcept;
+    };
+
+    typedef cxxabi_exception_counter exception_counter;
+#else
+    // Counts uncaught exceptions with std::uncaught_exceptions
+    struct std_exception_counter
+    {
+      static int count() noexcept;
+    };
+
+    typedef std_exception_counter exception_counter;
+#endif
+
+    /* Calls back when leaving scope by exception (OnFailure) or normally
+    (!OnFailure), by comparing uncaught exception counts at construction and
+    destruction. The counter is part of the type, so that translation units
+    with different options do not violate the ODR. */
+#ifdef SG_HAS_CONCEPTS
+    template<scope_guard_callback Callback,
+             bool OnFailure,
+             typename Counter = exception_counter,
+             typename = void>
+#else
+    template<typename Callback,
+             bool OnFailure,
+             typename Counter = exception_counter,
+             typename = typename std::enable_if<
+               is_proper_sg_callback_t<Callback>::value>::type>
+#endif
+    class conditional_scope_exit;
+
+    template<SG_CALLBACK_TYPENAME Callback>
+    detail::conditional_scope_exit<Callback, true>
+    make_scope_fail(Callback&& callback)
+    noexcept(is_nothrow_self_constructible_t<Callback>::value); /*
+    in the inner namespace for the same reason as make_scope_guard */
+
+    template<SG_CALLBACK_TYPENAME Callback>
+    detail::conditional_scope_exit<Callback, false>
+    make_scope_success(Callback&& callback)
+    noexcept(is_nothrow_self_constructible_t<Callback>::value); //idem
+
+    template<SG_CALLBACK_TYPENAME Callback, bool OnFailure, typename Counter>
+    class conditional_scope_exit<Callback, OnFailure, Counter> final
+      : private callback_storage<Callback>
+    {
+    public:
+      typedef Callback callback_type;
+
+      ~conditional_scope_exit() noexcept; // calls back depending on the exit
+
+    public:
+      conditional_scope_exit() = delete;
+      conditional_scope_exit(const conditional_scope_exit&) = delete;
+      conditional_scope_exit&
+      operator=(const conditional_scope_exit&) = delete;
+      conditional_scope_exit& operator=(conditional_scope_exit&&) = delete;
+
+#if __cplusplus >= 201703L
+      conditional_scope_exit(conditional_scope_exit&&) = delete; /* the
+      count snapshot only makes sense in the scope where it was taken */
+#else
+      conditional_scope_exit(conditional_scope_exit&&) noexcept; /* declared,
+      but never defined, as for scope_exit */
+#endif
+
+    private:
+      explicit conditional_scope_exit(Callback&& callback)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value); /*
+                                                      meant for friends only */
+
+      friend conditional_scope_exit<Callback, true>
+      make_scope_fail<Callback>(Callback&&)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value);
+
+      friend conditional_scope_exit<Callback, false>
+      make_scope_success<Callback>(Callback&&)
+      noexcept(is_nothrow_self_constructible_t<Callback>::value);
+
+    private:
+      int m_uncaught_exceptions; // when constructed
+
+    };
+#endif
+
+
+#if __cplusplus >= 201703L
+    /* --- Callbacks known at compile time (auto template parameters) --- */
+
+    // A stateless callback that calls a function known at compile time
+    template<auto Function>
+    struct function_callback
+    {
+      template<auto F = Function> // template, for SFINAE
+      auto operator()() const noexcept(noexcept(F())) -> decltype(F());
+    };
+
+    /* A callback that calls a method known at compile time on an object known
+    at runtime */
+    template<auto Method, typename Object>
+    class method_callback
+    {
+    public:
+      explicit method_callback(Object& object) noexcept;
+
+      template<auto M = Method> // template, for SFINAE
+      auto operator()() const
+      noexcept(noexcept((std::declval<Object&>().*M)()))
+      -> decltype((std::declval<Object&>().*M)());
+
+    private:
+      Object* m_object;
+    };
+
+    template<auto Function>
+    auto make_scope_guard(
+#ifdef SG_INSTRUMENT
+      std::source_location location = std::source_location::current()
+#endif
+    ) noexcept
+    -> decltype(make_scope_guard(function_callback<Function>{}));
+
+    template<auto Method, typename Object>
+    auto make_scope_guard(Object& object
+#ifdef SG_INSTRUMENT
+      , std::source_location location = std::source_location::current()
+#endif
+    ) noexcept
+    -> decltype(make_scope_guard(method_callback<Method, Object>{object}));
+#endif
+
+  } // namespace detail
+
+
+  /* --- Now the public maker functions --- */
+
+  SG_EXPORT using detail::make_scope_guard; // see comment on declaration above
+  SG_EXPORT using detail::make_scope_exit; // idem
+
+  SG_EXPORT typedef detail::commit_token commit_token; /* not a
+  using-declaration, which GCC 12 fails to export for classes */
+  SG_EXPORT using detail::make_token_guard; // idem
+  SG_EXPORT using detail::make_status_guard; // idem
+
+#ifdef SG_HAS_UNCAUGHT_EXCEPTIONS
+  SG_EXPORT using detail::make_scope_fail; // idem
+  SG_EXPORT using detail::make_scope_success; // idem
+#endif
+
+#ifdef SG_INSTRUMENT
+  /* --- The counters of instrumented builds --- */
+
+  // A snapshot of the counters of a call site of make_scope_guard
+  SG_EXPORT struct guard_site_counts
+  {
+    const char* file; // null for the entry of sites beyond the table
+    const char* function; // idem
+    std::uint_least32_t line;
+    std::uint_least32_t column;
+    std::uint64_t created; // guards made at the site
+    std::uint64_t fired; // guards that executed their callback
+    std::uint64_t dismissed; // guards dismissed while active
+    std::uint64_t moved_from; // guards that were move-constructed from
+  };
+
+  SG_EXPORT template<typename Visitor>
+  void for_each_guard_site(Visitor&& visit); /* calls visit with the
+  guard_site_counts of each site where guards were made */
+
+  SG_EXPORT void dump_guard_sites(std::ostream& out); // one line per site
+#endif
+
+
+  /* --- And the public type traits --- */
+
+  /* Type trait determining whether make_scope_guard accepts an argument of type
+  T&& (i.e. whether T is a proper callback, as deduced from that argument) */
+  SG_EXPORT template<typename T>
+  struct is_scope_guard_callback
+    : public std::integral_constant<bool,
+                                    detail::is_proper_sg_callback_t<T>::value>
+  {};
+
+#if __cplusplus >= 201402L
+  SG_EXPORT template<typename T>
+  constexpr bool is_scope_guard_callback_v = is_scope_guard_callback<T>::value;
+#endif
+
+  /* Type trait determining whether objects of type T can be relocated (moved to
+  other storage, with the originals dropped without destruction) by copying
+  their bytes. True for references, for types that are trivially move
+  constructible and destructible and, where the compiler can tell, for other
+  types it knows to be trivially relocatable. Clients MAY specialize it for
+  their own callback types. (Not based on std::is_trivially_copyable, which GCC
+  may get wrong for closures once they were stored in a guard.) */
+  SG_EXPORT template<typename T>
+  struct is_trivially_relocatable
+    : public std::integral_constant<bool,
+                                    std::is_reference<T>::value ||
+                                    (std::is_trivially_move_constructible<
+                                       T>::value &&
+                                     std::is_trivially_destructible<T>::value)
+#ifdef SG_IS_TRIVIALLY_RELOCATABLE
+                                    || SG_IS_TRIVIALLY_RELOCATABLE(T)
+#endif
+                                    >
+  {};
+
+  // scope_guards are trivially relocatable when their callbacks are
+  template<SG_CALLBACK_TYPENAME Callback>
+  struct is_trivially_relocatable<detail::scope_guard<Callback>>
+    : public is_trivially_relocatable<Callback>
+  {}; /* the activity flag is copied along, and the original is never
+  destroyed, so it is not cleared */
+
+#if __cplusplus >= 201402L
+  SG_EXPORT template<typename T>
+  constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+#endif
+
+} // namespace sg
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Callback, std::size_t Index, typename Enable>
+sg::detail::callback_storage<Callback, Index, Enable>::callback_storage(
+  Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+  : m_callback(std::forward<Callback>(callback)) /* use () instead of {} because
+    of DR 1467 (https://is.gd/WHmWuo), which still impacts older compilers
+    (e.g. GCC 4.x and clang <=3.6, see https://godbolt.org/g/TE9tPJ and
+    https://is.gd/Tsmh8G) */
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Callback, std::size_t Index, typename Enable>
+inline Callback&
+sg::detail::callback_storage<Callback, Index, Enable>::callback() noexcept
+{
+  return m_callback;
+}
+
+#ifndef SG_NO_UNIQUE_ADDRESS
+////////////////////////////////////////////////////////////////////////////////
+template<typename Callback, std::size_t Index>
+sg::detail::callback_storage<Callback, Index, typename std::enable_if<
+  sg::detail::is_empty_base_candidate_t<Callback>::value>::type>::
+callback_storage(Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+  : Callback(std::forward<Callback>(callback)) // idem
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Callback, std::size_t Index>
+inline Callback& sg::detail::callback_storage<Callback, Index,
+  typename std::enable_if<
+    sg::detail::is_empty_base_candidate_t<Callback>::value>::type>::callback()
+noexcept
+{
+  return *this;
+}
+#endif
+
+#ifdef SG_INSTRUMENT
+////////////////////////////////////////////////////////////////////////////////
+inline sg::detail::guard_site* sg::detail::guard_sites() noexcept
+{
+  static guard_site sites[SG_INSTRUMENT_MAX_SITES + 1]; /* constant
+  initialization, so no guard */
+  return sites;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::detail::guard_site&
+sg::detail::find_guard_site(const std::source_location& location) noexcept
+{
+  const auto sites = guard_sites();
+  const auto file = location.file_name();
+  const auto line = location.line();
+  const auto column = location.column();
+
+  auto index = (line * 2654435761u ^ column) % SG_INSTRUMENT_MAX_SITES;
+  for(auto probes = 0u; probes < SG_INSTRUMENT_MAX_SITES; ++probes)
+  {
+    auto& site = sites[index];
+    auto state = site.m_state.load(std::memory_order_acquire);
+    if(state == guard_site::empty &&
+       site.m_state.compare_exchange_strong(state, guard_site::claimed,
+                                            std::memory_order_acquire))
+    {
+      site.m_file = file;
+      site.m_function = location.function_name();
+      site.m_line = line;
+      site.m_column = column;
+      site.m_state.store(guard_site::ready, std::memory_order_release);
+      return site;
+    }
+
+    while(state == guard_site::claimed) // only while the key is written
+      state = site.m_state.load(std::memory_order_acquire);
+
+    if(site.m_line == line && site.m_column == column &&
+       (site.m_file == file || !std::strcmp(site.m_file, file))) /* literals
+       may not be merged across translation units */
+      return site;
+
+    index = (index + 1) % SG_INSTRUMENT_MAX_SITES;
+  }
+
+  return sites[SG_INSTRUMENT_MAX_SITES]; // the table is full
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Visitor>
+void sg::for_each_guard_site(Visitor&& visit)
+{
+  const auto sites = detail::guard_sites();
+  for(auto i = 0u; i <= SG_INSTRUMENT_MAX_SITES; ++i)
+  {
+    const auto& site = sites[i];
+    if(site.m_state.load(std::memory_order_acquire) !=
+         detail::guard_site::ready &&
+       !site.m_created.load(std::memory_order_relaxed))
+      continue; // never used
+
+    const guard_site_counts counts{
+      site.m_file, site.m_function, site.m_line, site.m_column,
+      site.m_created.load(std::memory_order_relaxed),
+      site.m_fired.load(std::memory_order_relaxed),
+      site.m_dismissed.load(std::memory_order_relaxed),
+      site.m_moved_from.load(std::memory_order_relaxed)};
+    visit(counts);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::dump_guard_sites(std::ostream& out)
+{
+  for_each_guard_site([&out](const guard_site_counts& site)
+  {
+    if(site.file)
+      out << site.file << ':' << site.line << ':' << site.column << " ("
+          << site.function << ')';
+    else
+      out << "(other sites)";
+    out << ": created " << site.created << ", fired " << site.fired
+        << ", dismissed " << site.dismissed << ", moved-from "
+        << site.moved_from << '\n';
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+sg::detail::scope_guard<Callback>::scope_guard(Callback&& callback,
+                                               guard_site& site)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+  : callback_storage<Callback>(std::forward<Callback>(callback))
+  , m_active{true}
+  , m_site{&site}
+{
+  m_site->m_created.fetch_add(1u, std::memory_order_relaxed);
+}
+#else
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+sg::detail::scope_guard<Callback>::scope_guard(Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+  : callback_storage<Callback>(std::forward<Callback>(callback))
+  , m_active{true}
+{}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+sg::detail::scope_guard<Callback>::~scope_guard() noexcept
+{
+#ifdef SG_INSTRUMENT
+  if(m_active)
+    m_site->m_fired.fetch_add(1u, std::memory_order_relaxed);
+#endif
+  if(m_active)
+    this->callback()();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+sg::detail::scope_guard<Callback>::scope_guard(scope_guard&& other)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+  : callback_storage<Callback>(std::forward<Callback>(other.callback()))
+  , m_active{std::move(other.m_active)}
+#ifdef SG_INSTRUMENT
+  , m_site{other.m_site}
+#endif
+{
+  other.m_active = false;
+#ifdef SG_INSTRUMENT
+  m_site->m_moved_from.fetch_add(1u, std::memory_order_relaxed);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+inline void sg::detail::scope_guard<Callback>::dismiss() noexcept
+{
+#ifdef SG_INSTRUMENT
+  if(m_active)
+    m_site->m_dismissed.fetch_add(1u, std::memory_order_relaxed);
+#endif
+  m_active = false;
+}
+
+#ifdef SG_INSTRUMENT
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+inline auto sg::detail::make_scope_guard(Callback&& callback,
+                                         std::source_location location)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+-> detail::scope_guard<Callback>
+{
+  return detail::scope_guard<Callback>{std::forward<Callback>(callback),
+                                       find_guard_site(location)};
+}
+#else
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+inline auto sg::detail::make_scope_guard(Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+-> detail::scope_guard<Callback>
+{
+  return detail::scope_guard<Callback>{std::forward<Callback>(callback)};
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+sg::detail::scope_exit<Callback>::scope_exit(Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+  : callback_storage<Callback>(std::forward<Callback>(callback))
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+sg::detail::scope_exit<Callback>::~scope_exit() noexcept
+{
+  this->callback()();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+inline auto sg::detail::make_scope_exit(Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+-> detail::scope_exit<Callback>
+{
+  return detail::scope_exit<Callback>{std::forward<Callback>(callback)};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t... Indices, typename... Callbacks>
+sg::detail::multi_scope_guard<sg::detail::index_sequence<Indices...>,
+                              Callbacks...>::
+multi_scope_guard(Callbacks&&... callbacks)
+noexcept(are_nothrow_self_constructible_t<Callbacks...>::value)
+  : callback_storage<Callbacks, Indices>(std::forward<Callbacks>(callbacks))...
+  , m_active(static_cast<mask_type>(~mask_type{0})) // all active
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t... Indices, typename... Callbacks>
+sg::detail::multi_scope_guard<sg::detail::index_sequence<Indices...>,
+                              Callbacks...>::~multi_scope_guard() noexcept
+{
+  using expand = int[];
+  (void)expand{(call_back_if_active<sizeof...(Callbacks) - 1 - Indices>(),
+                0)...}; // in reverse order of declaration
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t... Indices, typename... Callbacks>
+sg::detail::multi_scope_guard<sg::detail::index_sequence<Indices...>,
+                              Callbacks...>::
+multi_scope_guard(multi_scope_guard&& other)
+noexcept(are_nothrow_self_constructible_t<Callbacks...>::value)
+  : callback_storage<Callbacks, Indices>(std::forward<Callbacks>(
+      other.callback_storage<Callbacks, Indices>::callback()))...
+  , m_active{std::move(other.m_active)}
+{
+  other.m_active = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t... Indices, typename... Callbacks>
+inline void
+sg::detail::multi_scope_guard<sg::detail::index_sequence<Indices...>,
+                              Callbacks...>::dismiss() noexcept
+{
+  m_active = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t... Indices, typename... Callbacks>
+template<std::size_t Index>
+inline void
+sg::detail::multi_scope_guard<sg::detail::index_sequence<Indices...>,
+                              Callbacks...>::dismiss() noexcept
+{
+  static_assert(Index < sizeof...(Callbacks), "callback index out of range");
+  m_active = static_cast<mask_type>(m_active & ~(mask_type{1} << Index));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t... Indices, typename... Callbacks>
+template<std::size_t Index>
+inline void
+sg::detail::multi_scope_guard<sg::detail::index_sequence<Indices...>,
+                              Callbacks...>::call_back_if_active() noexcept
+{
+  if(m_active & (mask_type{1} << Index))
+    this->callback_storage<callback_type<Index>, Index>::callback()();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback1,
+         SG_CALLBACK_TYPENAME Callback2,
+         SG_CALLBACK_TYPENAME... Callbacks>
+inline auto sg::detail::make_scope_guard(Callback1&& callback1,
+                                         Callback2&& callback2,
+                                         Callbacks&&... callbacks)
+noexcept(are_nothrow_self_constructible_t<Callback1,
+                                          Callback2,
+                                          Callbacks...>::value)
+-> typename std::enable_if<
+     are_proper_sg_callbacks_t<Callback1, Callback2, Callbacks...>::value,
+     multi_scope_guard_t<Callback1, Callback2, Callbacks...>>::type
+{
+  return multi_scope_guard_t<Callback1, Callback2, Callbacks...>{
+    std::forward<Callback1>(callback1),
+    std::forward<Callback2>(callback2),
+    std::forward<Callbacks>(callbacks)...};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::detail::commit_token::commit_token() noexcept
+  : m_committed{false}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::detail::commit_token::commit() noexcept
+{
+  m_committed = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline bool sg::detail::commit_token::is_committed() const noexcept
+{
+  return m_committed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+sg::detail::token_scope_guard<Callback>::token_scope_guard(
+  const commit_token& token, Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+  : callback_storage<Callback>(std::forward<Callback>(callback))
+  , m_token{&token}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+sg::detail::token_scope_guard<Callback>::token_scope_guard(
+  token_scope_guard&& other)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+  : callback_storage<Callback>(std::forward<Callback>(other.callback()))
+  , m_token{other.m_token}
+{
+  other.m_token = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+sg::detail::token_scope_guard<Callback>::~token_scope_guard() noexcept
+{
+  if(m_token && !m_token->is_committed())
+    this->callback()();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+inline void sg::detail::token_scope_guard<Callback>::dismiss() noexcept
+{
+  m_token = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+inline auto sg::detail::make_token_guard(const commit_token& token,
+                                         Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+-> detail::token_scope_guard<Callback>
+{
+  return detail::token_scope_guard<Callback>{token,
+                                             std::forward<Callback>(callback)};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Status, SG_CALLBACK_TYPENAME Callback>
+sg::detail::status_scope_guard<Status, Callback>::status_scope_guard(
+  const Status& status, Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+  : callback_storage<Callback>(std::forward<Callback>(callback))
+  , m_status{&status}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Status, SG_CALLBACK_TYPENAME Callback>
+sg::detail::status_scope_guard<Status, Callback>::status_scope_guard(
+  status_scope_guard&& other)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+  : callback_storage<Callback>(std::forward<Callback>(other.callback()))
+  , m_status{other.m_status}
+{
+  other.m_status = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Status, SG_CALLBACK_TYPENAME Callback>
+sg::detail::status_scope_guard<Status, Callback>::~status_scope_guard() noexcept
+{
+  if(m_status && static_cast<bool>(*m_status))
+    this->callback()();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Status, SG_CALLBACK_TYPENAME Callback>
+inline void sg::detail::status_scope_guard<Status, Callback>::dismiss() noexcept
+{
+  m_status = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename Status, SG_CALLBACK_TYPENAME Callback>
+inline auto sg::detail::make_status_guard(const Status& status,
+                                          Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+-> detail::status_scope_guard<Status, Callback>
+{
+  return detail::status_scope_guard<Status, Callback>{
+    status, std::forward<Callback>(callback)};
+}
+
+#ifdef SG_HAS_UNCAUGHT_EXCEPTIONS
+#ifdef SG_UNCAUGHT_EXCEPTIONS_FROM_CXXABI
+////////////////////////////////////////////////////////////////////////////////
+inline int sg::detail::cxxabi_exception_counter::count() noexcept
+{
+  static thread_local const unsigned int* uncaught = nullptr; /* constant
+  initialization, so no guard */
+  if(!uncaught)
+    uncaught = &reinterpret_cast<const cxa_eh_globals_prefix*>(
+      abi::__cxa_get_globals())->m_uncaught_exceptions;
+
+  return static_cast<int>(*uncaught);
+}
+#else
+////////////////////////////////////////////////////////////////////////////////
+inline int sg::detail::std_exception_counter::count() noexcept
+{
+  return std::uncaught_exceptions();
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback, bool OnFailure, typename Counter>
+sg::detail::conditional_scope_exit<Callback, OnFailure, Counter>::
+conditional_scope_exit(Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+  : callback_storage<Callback>(std::forward<Callback>(callback))
+  , m_uncaught_exceptions{Counter::count()}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback, bool OnFailure, typename Counter>
+sg::detail::conditional_scope_exit<Callback, OnFailure, Counter>::
+~conditional_scope_exit() noexcept
+{
+  if((Counter::count() > m_uncaught_exceptions) == OnFailure)
+    this->callback()();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+inline auto sg::detail::make_scope_fail(Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+-> detail::conditional_scope_exit<Callback, true>
+{
+  return detail::conditional_scope_exit<Callback, true>{
+    std::forward<Callback>(callback)};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<SG_CALLBACK_TYPENAME Callback>
+inline auto sg::detail::make_scope_success(Callback&& callback)
+noexcept(is_nothrow_self_constructible_t<Callback>::value)
+-> detail::conditional_scope_exit<Callback, false>
+{
+  return detail::conditional_scope_exit<Callback, false>{
+    std::forward<Callback>(callback)};
+}
+#endif
+
+#if __cplusplus >= 201703L
+////////////////////////////////////////////////////////////////////////////////
+template<auto Function>
+template<auto F>
+inline auto sg::detail::function_callback<Function>::operator()() const
+noexcept(noexcept(F())) -> decltype(F())
+{
+  return F();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<auto Method, typename Object>
+sg::detail::method_callback<Method, Object>::method_callback(Object& object)
+noexcept
+  : m_object{&object}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+template<auto Method, typename Object>
+template<auto M>
+inline auto sg::detail::method_callback<Method, Object>::operator()() const
+noexcept(noexcept((std::declval<Object&>().*M)()))
+-> decltype((std::declval<Object&>().*M)())
+{
+  return (m_object->*M)();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<auto Function>
+inline auto sg::detail::make_scope_guard(
+#ifdef SG_INSTRUMENT
+  std::source_location location
+#endif
+) noexcept
+-> decltype(make_scope_guard(function_callback<Function>{}))
+{
+#ifdef SG_INSTRUMENT
+  return make_scope_guard(function_callback<Function>{}, location); /* counted
+  where this maker was called */
+#else
+  return make_scope_guard(function_callback<Function>{});
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<auto Method, typename Object>
+inline auto sg::detail::make_scope_guard(Object& object
+#ifdef SG_INSTRUMENT
+  , std::source_location location
+#endif
+) noexcept
+-> decltype(make_scope_guard(method_callback<Method, Object>{object}))
+{
+#ifdef SG_INSTRUMENT
+  return make_scope_guard(method_callback<Method, Object>{object}, location);
+#else
+  return make_scope_guard(method_callback<Method, Object>{object});
+#endif
+}
+#endif
 
 #endif /* SCOPE_GUARD_HPP_ */
@@ -0,0 +1,283 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * Multi-threaded stress tests of atomic_scope_guard, of the per-thread
+ * histograms of latency guards and of the per-thread buffers of trace zones.
+ * Besides the checks here, these are meant to be built with a thread sanitizer,
+ * which then confirms that there are no data races (see docs/tests.md).
+ */
+
+#include "atomic_scope_guard.hpp"
+#include "latency_guard.hpp"
+#define SG_ENABLE_TRACE
+#include "trace_zone.hpp"
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main()
+#include "catch/catch.hpp"
+
+#include <atomic>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sg;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  constexpr auto rounds = 500u;
+  constexpr auto racers = 4u;
+
+  // spins until go is set, so that threads start racing together
+  void wait_for(const std::atomic<bool>& go) noexcept
+  {
+    while(!go.load(std::memory_order_acquire))
+      std::this_thread::yield();
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When several threads race to try_dismiss an atomic_scope_guard, "
+          "exactly one of them wins and the callback is not executed.")
+{
+  auto calls = 0u;
+  for(auto round = 0u; round < rounds; ++round)
+  {
+    auto winner = racers; // plain data, only written by the winner
+    std::atomic<unsigned> wins{0u};
+    {
+      auto guard = make_atomic_scope_guard([&calls]() noexcept { ++calls; });
+      std::atomic<bool> go{false};
+
+      std::vector<std::thread> threads;
+      for(auto id = 0u; id < racers; ++id)
+        threads.emplace_back([&guard, &go, &winner, &wins, id]()
+        {
+          wait_for(go);
+          if(guard.try_dismiss())
+          {
+            winner = id; // a race here, were there two winners
+            wins.fetch_add(1u, std::memory_order_relaxed);
+          }
+        });
+
+      go.store(true, std::memory_order_release);
+      for(auto& thread : threads)
+        thread.join();
+    }
+
+    REQUIRE(wins.load() == 1u);
+    REQUIRE(winner < racers);
+  }
+
+  REQUIRE_FALSE(calls);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When a completion thread races with the submitting thread to "
+          "dismiss an atomic_scope_guard, the winner's writes are visible to "
+          "the loser, and the callback is not executed.")
+{
+  auto calls = 0u, completions = 0u, cancellations = 0u;
+  for(auto round = 1u; round <= rounds; ++round)
+  {
+    auto result = 0u; // plain data, handed over through the guard
+    {
+      auto guard = make_atomic_scope_guard([&calls]() noexcept { ++calls; });
+      std::atomic<bool> go{false};
+
+      std::thread completion{[&guard, &go, &result, round]()
+      {
+        wait_for(go);
+        result = round; // written before trying, read by the submitter...
+        guard.try_dismiss(); // ...if this wins
+      }};
+
+      go.store(true, std::memory_order_release);
+      if(round % 2u)
+        std::this_thread::yield(); // give the completion a head start
+
+      if(guard.try_dismiss()) // cancel
+        ++cancellations;
+      else // completed: the exchange acquired the result
+      {
+        REQUIRE(result == round);
+        ++completions;
+      }
+
+      completion.join();
+    }
+  }
+
+  REQUIRE_FALSE(calls);
+  REQUIRE(completions + cancellations == rounds);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("When a thread races to try_dismiss an atomic_scope_guard that is "
+          "being destroyed, either the callback is executed or try_dismiss "
+          "returns true, but never both.")
+{
+  auto calls = 0u, dismissals = 0u;
+  for(auto round = 0u; round < rounds; ++round)
+  {
+    auto fired = false, won = false; // plain data, handed over through guard
+    std::atomic<bool> go{false}, tried{false};
+    const auto cb = [&fired, &tried]() noexcept
+    {
+      fired = true;
+      wait_for(tried); // so that the racing call happens during destruction
+    };
+    using guard_type = decltype(make_atomic_scope_guard(cb));
+
+    alignas(guard_type) unsigned char storage[sizeof(guard_type)];
+    auto guard = ::new(storage) guard_type{make_atomic_scope_guard(cb)};
+
+    std::thread dismisser{[guard, &go, &tried, &won]()
+    {
+      wait_for(go);
+      won = guard->try_dismiss();
+      tried.store(true, std::memory_order_release);
+    }};
+
+    go.store(true, std::memory_order_release);
+    if(round % 2u)
+      std::this_thread::yield(); // give the dismisser a head start
+
+    guard->~guard_type(); // storage outlives the dismisser's call
+    dismisser.join();
+
+    REQUIRE(fired != won);
+    calls += fired;
+    dismissals += won;
+  }
+
+  REQUIRE(calls + dismissals == rounds);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("atomic_scope_guards that are created on one thread and dismissed "
+          "on another execute their callbacks exactly when not dismissed.")
+{
+  auto calls = 0u;
+  const auto inc_calls = [&calls]() noexcept { ++calls; };
+  using guard_type = decltype(make_atomic_scope_guard(inc_calls));
+
+  {
+    std::vector<guard_type> guards;
+    guards.reserve(rounds); // no reallocation, while the other thread works
+    for(auto i = 0u; i < rounds; ++i)
+      guards.push_back(make_atomic_scope_guard(inc_calls));
+
+    std::atomic<bool> go{false};
+    std::thread completion{[&guards, &go]()
+    {
+      wait_for(go);
+      for(auto i = 0u; i < rounds; i += 2u)
+        guards[i].dismiss(); // completes every other operation
+    }};
+
+    go.store(true, std::memory_order_release);
+    for(auto i = 1u; i < rounds; i += 4u)
+      guards[i].dismiss(); // and the submitter cancels some of the others
+
+    completion.join();
+  } // the guards are destroyed here, on the submitting thread
+
+  REQUIRE(calls == rounds / 4u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Latency guards on several threads record at a shared site without "
+          "losing records, while another thread merges the histograms.")
+{
+  static latency_site site{"threads/shared"};
+  std::atomic<bool> go{false}, done{false};
+  auto went_back = false; // plain data, read after joining the reader
+
+  std::thread reader{[&go, &done, &went_back]()
+  {
+    wait_for(go);
+    auto last = std::uint64_t{0};
+    while(!done.load(std::memory_order_acquire))
+    {
+      const auto seen = site.histogram().count(); // may be partial...
+      went_back = went_back || seen < last; // ...but should never go back
+      last = seen;
+    }
+  }};
+
+  for(auto generation = 0u; generation < 3u; ++generation) // reuse blocks
+  {
+    std::vector<std::thread> threads;
+    for(auto id = 0u; id < racers; ++id)
+      threads.emplace_back([&go]()
+      {
+        wait_for(go);
+        for(auto i = 0u; i < rounds; ++i)
+          const auto guard = make_latency_guard(site);
+      });
+
+    go.store(true, std::memory_order_release);
+    for(auto& thread : threads)
+      thread.join(); // their blocks are released, for the next generation
+  }
+
+  done.store(true, std::memory_order_release);
+  reader.join();
+
+  REQUIRE_FALSE(went_back);
+  REQUIRE(site.histogram().count() == 3u * racers * rounds);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Trace zones on several threads are all flushed, once, by another "
+          "thread that flushes while they run.")
+{
+  constexpr auto zones = rounds / 4u; // per thread, all fit in a single buffer
+  std::atomic<bool> go{false}, done{false};
+  std::string trace; // plain data, read after joining the flusher
+
+  std::thread flusher{[&go, &done, &trace]()
+  {
+    wait_for(go);
+    auto last = false;
+    while(!last)
+    {
+      last = done.load(std::memory_order_acquire); // then one more flush
+      std::ostringstream out;
+      flush_trace(out);
+      trace += out.str();
+    }
+  }};
+
+  for(auto generation = 0u; generation < 3u; ++generation) // reuse buffers
+  {
+    std::vector<std::thread> threads;
+    for(auto id = 0u; id < racers; ++id)
+      threads.emplace_back([&go]()
+      {
+        wait_for(go);
+        for(auto i = 0u; i < zones; ++i)
+        {
+          SG_TRACE_ZONE("threads/zone");
+        }
+      });
+
+    go.store(true, std::memory_order_release);
+    for(auto& thread : threads)
+      thread.join();
+  }
+
+  done.store(true, std::memory_order_release);
+  flusher.join();
+
+  auto begins = 0u;
+  for(auto pos = trace.find("\"ph\": \"B\""); pos != std::string::npos;
+      pos = trace.find("\"ph\": \"B\"", pos + 1))
+    ++begins;
+  REQUIRE(begins == 3u * racers * zones); // exited threads' buffers are reused
+}
@@ -0,0 +1,326 @@
+/*
+ *  Created on: 16/10/2026
+ *      Author: ricab
+ *
+ * See docs/interface.md for documentation of this header's public interface.
+ */
+
+#ifndef TRACE_ZONE_HPP_
+#define TRACE_ZONE_HPP_
+
+#include "scope_guard.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <ostream>
+#include <vector>
+
+#ifndef SG_TRACE_BUFFER_EVENTS
+#define SG_TRACE_BUFFER_EVENTS 8192 // per thread, the newest are kept
+#endif
+
+namespace sg
+{
+  void flush_trace(std::ostream& out); /* drains the events of all threads, as
+  Chrome trace-event JSON */
+
+  namespace detail
+  {
+    static_assert(SG_TRACE_BUFFER_EVENTS > 0 &&
+                  (SG_TRACE_BUFFER_EVENTS & (SG_TRACE_BUFFER_EVENTS - 1)) == 0,
+                  "SG_TRACE_BUFFER_EVENTS must be a power of two");
+
+    // An event slot, read by flushes while its thread may overwrite it
+    struct trace_event final
+    {
+      std::atomic<const char*> m_name;
+      std::atomic<std::uint64_t> m_ns;
+      std::atomic<bool> m_begin; // or end
+    };
+
+    /* The ring buffer of a thread, with a single writer. Buffers are never
+    freed: when their thread exits, they are released, to be reused by another
+    thread (with the same tid). */
+    struct trace_buffer final
+    {
+      std::atomic<bool> m_in_use;
+      trace_buffer* m_next; // immutable once published
+      unsigned m_tid; // idem
+      std::atomic<std::uint64_t> m_writing; // events started
+      std::atomic<std::uint64_t> m_written; // events finished
+      std::uint64_t m_flushed; // by flush_trace only
+      std::array<trace_event, SG_TRACE_BUFFER_EVENTS> m_events;
+    };
+
+    // A lock-free list of buffers, only ever pushed to
+    struct trace_registry final
+    {
+      constexpr trace_registry() noexcept
+        : m_buffers{nullptr}, m_buffer_count{0u}
+      {}
+
+      std::atomic<trace_buffer*> m_buffers;
+      std::atomic<unsigned> m_buffer_count;
+    };
+
+    trace_registry& the_trace_registry() noexcept;
+
+    // This thread's buffer, if claimed, and whether the thread is exiting
+    struct trace_thread_state final
+    {
+      trace_buffer* m_buffer;
+      bool m_exited;
+    };
+
+    trace_thread_state& this_thread_trace_state() noexcept;
+    trace_buffer* claim_trace_buffer() noexcept; // for this thread
+
+    std::uint64_t trace_now() noexcept; // steady_clock, in nanoseconds
+    void write_trace_event(const char* name, bool begin) noexcept; /*
+    lock-free, and allocation-free once this thread has a buffer */
+
+    void write_json_string(std::ostream& out, const char* str);
+
+    // The callback of a trace zone: writes the end event
+    class trace_zone_end final
+    {
+    public:
+      explicit trace_zone_end(const char* name) noexcept;
+      void operator()() const noexcept;
+
+    private:
+      const char* m_name;
+
+    };
+
+    detail::scope_guard<trace_zone_end> begin_trace_zone(const char* name
+#ifdef SG_INSTRUMENT
+      , std::source_location location = std::source_location::current()
+#endif
+    ) noexcept; // writes the begin event
+
+  } // namespace detail
+
+} // namespace sg
+
+#define SG_TRACE_CONCAT_IMPL(a, b) a##b
+#define SG_TRACE_CONCAT(a, b) SG_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef __COUNTER__ // GCC, Clang and MSVC: unique even within a line
+#define SG_TRACE_UNIQUE __COUNTER__
+#else
+#define SG_TRACE_UNIQUE __LINE__
+#endif
+
+/* Traces the rest of the enclosing scope as a zone with the given name, which
+must be a string literal. Without SG_ENABLE_TRACE, this expands to nothing. */
+#ifdef SG_ENABLE_TRACE
+#define SG_TRACE_ZONE(name)                                                    \
+  const auto SG_TRACE_CONCAT(sg_trace_zone_, SG_TRACE_UNIQUE) =                \
+    ::sg::detail::begin_trace_zone(name)
+#else
+#define SG_TRACE_ZONE(name) static_cast<void>(0)
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::detail::trace_registry& sg::detail::the_trace_registry() noexcept
+{
+  static trace_registry registry; // constant initialization, so no guard
+  return registry;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::detail::trace_thread_state&
+sg::detail::this_thread_trace_state() noexcept
+{
+  static thread_local trace_thread_state state = {nullptr, false}; /*
+  constant initialization, so no guard */
+  return state;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::detail::trace_buffer* sg::detail::claim_trace_buffer() noexcept
+{
+  auto& registry = the_trace_registry();
+
+  auto buffer = registry.m_buffers.load(std::memory_order_acquire);
+  for(; buffer; buffer = buffer->m_next) // reuse one that a thread released
+    if(!buffer->m_in_use.load(std::memory_order_relaxed) &&
+       !buffer->m_in_use.exchange(true, std::memory_order_acquire))
+      break;
+
+  if(!buffer)
+  {
+    buffer = new(std::nothrow) trace_buffer{}; // zeroed
+    if(!buffer)
+      return nullptr;
+
+    buffer->m_in_use.store(true, std::memory_order_relaxed);
+    buffer->m_tid =
+      registry.m_buffer_count.fetch_add(1u, std::memory_order_relaxed);
+    buffer->m_next = registry.m_buffers.load(std::memory_order_relaxed);
+    while(!registry.m_buffers.compare_exchange_weak(buffer->m_next, buffer,
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed))
+      ;
+  }
+
+  struct releaser
+  {
+    ~releaser()
+    {
+      auto& state = this_thread_trace_state();
+      if(state.m_buffer)
+        state.m_buffer->m_in_use.store(false, std::memory_order_release);
+      state = {nullptr, true}; // later events are dropped
+    }
+  };
+  static thread_local releaser release_at_thread_exit;
+  (void)release_at_thread_exit;
+
+  return buffer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::uint64_t sg::detail::trace_now() noexcept
+{
+  return static_cast<std::uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::detail::write_trace_event(const char* name, bool begin) noexcept
+{
+  auto& state = this_thread_trace_state();
+  if(!state.m_buffer)
+  {
+    if(state.m_exited || !(state.m_buffer = claim_trace_buffer()))
+      return;
+  }
+
+  auto& buffer = *state.m_buffer;
+  const auto index = buffer.m_written.load(std::memory_order_relaxed);
+  buffer.m_writing.store(index + 1, std::memory_order_relaxed); /* ordered
+  before the overwrite by the release stores, so that flushes can tell */
+
+  auto& event = buffer.m_events[index & (SG_TRACE_BUFFER_EVENTS - 1)];
+  event.m_name.store(name, std::memory_order_release);
+  event.m_ns.store(trace_now(), std::memory_order_release);
+  event.m_begin.store(begin, std::memory_order_release);
+
+  buffer.m_written.store(index + 1, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::detail::write_json_string(std::ostream& out, const char* str)
+{
+  static const char hex[] = "0123456789abcdef";
+
+  out << '"';
+  for(; *str; ++str)
+  {
+    const auto c = static_cast<unsigned char>(*str);
+    if(c == '"' || c == '\\')
+      out << '\\' << *str;
+    else if(c < 0x20)
+      out << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+    else
+      out << *str;
+  }
+  out << '"';
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::detail::trace_zone_end::trace_zone_end(const char* name) noexcept
+  : m_name{name}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::detail::trace_zone_end::operator()() const noexcept
+{
+  write_trace_event(m_name, false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline auto sg::detail::begin_trace_zone(const char* name
+#ifdef SG_INSTRUMENT
+  , std::source_location location
+#endif
+) noexcept
+-> detail::scope_guard<trace_zone_end>
+{
+  write_trace_event(name, true);
+#ifdef SG_INSTRUMENT
+  return make_scope_guard(trace_zone_end{name}, location);
+#else
+  return make_scope_guard(trace_zone_end{name});
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::flush_trace(std::ostream& out)
+{
+  struct snapshot
+  {
+    const char* name;
+    std::uint64_t ns;
+    bool begin;
+  };
+
+  std::vector<snapshot> events;
+  const char* separator = "\n";
+  const auto capacity = std::uint64_t{SG_TRACE_BUFFER_EVENTS};
+
+  out << "{\"traceEvents\": [";
+  for(auto buffer =
+        detail::the_trace_registry().m_buffers.load(std::memory_order_acquire);
+      buffer;
+      buffer = buffer->m_next)
+  {
+    const auto end = buffer->m_written.load(std::memory_order_acquire);
+    auto first = end > capacity ? end - capacity : 0;
+    if(first < buffer->m_flushed)
+      first = buffer->m_flushed;
+
+    events.clear();
+    for(auto i = first; i < end; ++i)
+    {
+      const auto& event = buffer->m_events[i & (capacity - 1)];
+      events.push_back({event.m_name.load(std::memory_order_acquire),
+                        event.m_ns.load(std::memory_order_acquire),
+                        event.m_begin.load(std::memory_order_acquire)});
+    }
+
+    /* Slots that the thread started overwriting while they were read hold
+    torn events. If a load saw any of an overwrite, it acquired the matching
+    m_writing too (as in a seqlock), so those slots are skipped. */
+    const auto writing = buffer->m_writing.load(std::memory_order_relaxed);
+    const auto valid = writing > capacity + first ? writing - capacity : first;
+    buffer->m_flushed = end;
+
+    auto depth = std::size_t{0};
+    for(auto i = valid; i < end; ++i)
+    {
+      const auto& event = events[static_cast<std::size_t>(i - first)];
+      if(!event.begin && !depth)
+        continue; // its begin event was overwritten, or flushed before
+      depth += event.begin ? 1 : static_cast<std::size_t>(-1);
+
+      out << separator << "  {\"name\": ";
+      detail::write_json_string(out, event.name);
+      out << ", \"ph\": \"" << (event.begin ? 'B' : 'E') << "\", \"ts\": "
+          << event.ns / 1000u << '.' << event.ns / 100u % 10u
+          << event.ns / 10u % 10u << event.ns % 10u
+          << ", \"pid\": 1, \"tid\": " << buffer->m_tid << '}';
+      separator = ",\n";
+    }
+  }
+  out << "\n], \"displayTimeUnit\": \"ns\"}\n";
+}
+
+#endif /* TRACE_ZONE_HPP_ */
@@ -0,0 +1,301 @@
+/*
+ *  Created on: 15/10/2026
+ *      Author: ricab
+ *
+ * See docs/interface.md for documentation of this header's public interface.
+ */
+
+#ifndef UNDO_BUFFER_HPP_
+#define UNDO_BUFFER_HPP_
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace sg
+{
+  namespace detail
+  {
+    // Bookkeeping for one log entry, stored right after the entry's old bytes
+    struct undo_entry_trailer
+    {
+      void* m_destination;
+      std::size_t m_length;
+    };
+
+    // Rounds up to a multiple of the trailer's alignment
+    constexpr std::size_t undo_padded(std::size_t length) noexcept
+    {
+      return (length + alignof(undo_entry_trailer) - 1) &
+             ~(alignof(undo_entry_trailer) - 1);
+    }
+
+  } // namespace detail
+
+
+  /* --- A scope-bound log of old bytes, restored with memcpy on unwind --- */
+
+  class undo_buffer final
+  {
+  public:
+    class savepoint; // a position in the log
+
+    undo_buffer() noexcept;
+    ~undo_buffer() noexcept; // restores recorded bytes, last recorded first
+
+    void record(void* destination, std::size_t length); /* saves the bytes
+    currently in [destination, destination + length) */
+
+    template<typename T>
+    void record(T& object); // saves the bytes of a trivially copyable object
+
+    void reserve(std::size_t bytes); // arena capacity, including bookkeeping
+
+    void dismiss() noexcept; // discards everything recorded so far
+    void commit() noexcept; // same as dismiss
+
+    savepoint open_savepoint() noexcept; // later records can be rolled back
+    void rollback_to(savepoint point) noexcept; /* restores what was recorded
+    since point was opened (inner points are invalidated, point is not) */
+    void rollback() noexcept; // restores everything recorded so far
+
+    bool empty() const noexcept;
+
+  public:
+    undo_buffer(const undo_buffer&) = delete;
+    undo_buffer(undo_buffer&&) = delete;
+    undo_buffer& operator=(const undo_buffer&) = delete;
+    undo_buffer& operator=(undo_buffer&&) = delete;
+
+  private:
+    void grow(std::size_t required);
+    void restore_down_to(std::size_t position) noexcept;
+
+  private:
+    std::unique_ptr<unsigned char[]> m_arena; // entries: old bytes + trailer
+    std::size_t m_size; // bytes in use
+    std::size_t m_capacity;
+    std::size_t m_last; // where the last entry starts, if it can be extended
+
+    static constexpr std::size_t no_entry = static_cast<std::size_t>(-1);
+
+  };
+
+  // Committing a savepoint merely means not rolling back to it
+  class undo_buffer::savepoint final
+  {
+  public:
+    savepoint() noexcept; // at the beginning of the log
+
+  private:
+    friend class undo_buffer;
+    explicit savepoint(std::size_t position) noexcept;
+
+  private:
+    std::size_t m_position;
+
+  };
+
+
+  /* --- A nested scope within an undo_buffer --- */
+
+  class undo_scope final
+  {
+  public:
+    explicit undo_scope(undo_buffer& log) noexcept; // opens a savepoint
+    ~undo_scope() noexcept; // rolls back to the savepoint, unless committed
+
+    void commit() noexcept; // merges records into the enclosing scope
+    void dismiss() noexcept; // same as commit
+
+  public:
+    undo_scope(const undo_scope&) = delete;
+    undo_scope(undo_scope&&) = delete;
+    undo_scope& operator=(const undo_scope&) = delete;
+    undo_scope& operator=(undo_scope&&) = delete;
+
+  private:
+    undo_buffer& m_log;
+    undo_buffer::savepoint m_point;
+    bool m_active;
+
+  };
+
+} // namespace sg
+
+////////////////////////////////////////////////////////////////////////////////
+constexpr std::size_t sg::undo_buffer::no_entry;
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::undo_buffer::undo_buffer() noexcept
+  : m_arena{}
+  , m_size{0}
+  , m_capacity{0}
+  , m_last{no_entry}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::undo_buffer::~undo_buffer() noexcept
+{
+  restore_down_to(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::undo_buffer::record(void* destination, std::size_t length)
+{
+  if(!length)
+    return; // nothing to restore
+
+  auto start = m_size;
+  detail::undo_entry_trailer trailer{destination, 0};
+
+  if(m_last != no_entry) // try extending the last entry instead
+  {
+    std::memcpy(&trailer, m_arena.get() + m_size - sizeof(trailer),
+                sizeof(trailer));
+    if(static_cast<unsigned char*>(trailer.m_destination) + trailer.m_length ==
+       static_cast<unsigned char*>(destination)) // contiguous, so disjoint
+      start = m_last;
+    else
+      trailer = detail::undo_entry_trailer{destination, 0};
+  }
+
+  const auto offset = start + trailer.m_length; // where the new bytes go
+  trailer.m_length += length;
+  const auto padded = detail::undo_padded(trailer.m_length);
+  const auto required = start + padded + sizeof(trailer);
+  if(required > m_capacity)
+    grow(required); // only throwing point, nothing recorded if it does
+
+  std::memcpy(m_arena.get() + offset, destination, length);
+  std::memcpy(m_arena.get() + start + padded, &trailer, sizeof(trailer));
+  m_size = required;
+  m_last = start;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+inline void sg::undo_buffer::record(T& object)
+{
+  static_assert(std::is_trivially_copyable<T>::value,
+                "undo_buffer can only restore trivially copyable objects");
+  static_assert(!std::is_const<T>::value,
+                "undo_buffer cannot restore const objects");
+
+  record(static_cast<void*>(std::addressof(object)), sizeof(T));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::undo_buffer::reserve(std::size_t bytes)
+{
+  if(bytes > m_capacity)
+    grow(bytes);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::undo_buffer::dismiss() noexcept
+{
+  m_size = 0; // keeps the arena, for reuse
+  m_last = no_entry;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::undo_buffer::commit() noexcept
+{
+  dismiss();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline auto sg::undo_buffer::open_savepoint() noexcept -> savepoint
+{
+  m_last = no_entry; // so that no entry straddles the savepoint
+  return savepoint{m_size};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::undo_buffer::rollback_to(savepoint point) noexcept
+{
+  restore_down_to(point.m_position);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::undo_buffer::rollback() noexcept
+{
+  restore_down_to(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline bool sg::undo_buffer::empty() const noexcept
+{
+  return !m_size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::undo_buffer::grow(std::size_t required)
+{
+  auto capacity = m_capacity ? 2 * m_capacity : std::size_t{256};
+  while(capacity < required)
+    capacity *= 2;
+
+  std::unique_ptr<unsigned char[]> arena{new unsigned char[capacity]};
+  if(m_size)
+    std::memcpy(arena.get(), m_arena.get(), m_size);
+
+  m_arena.swap(arena);
+  m_capacity = capacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::undo_buffer::restore_down_to(std::size_t position) noexcept
+{
+  detail::undo_entry_trailer trailer;
+  while(m_size > position)
+  {
+    m_size -= sizeof(trailer);
+    std::memcpy(&trailer, m_arena.get() + m_size, sizeof(trailer));
+    m_size -= detail::undo_padded(trailer.m_length);
+    std::memcpy(trailer.m_destination, m_arena.get() + m_size,
+                trailer.m_length);
+  }
+
+  m_last = no_entry;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::undo_buffer::savepoint::savepoint() noexcept
+  : m_position{0}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::undo_buffer::savepoint::savepoint(std::size_t position) noexcept
+  : m_position{position}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::undo_scope::undo_scope(undo_buffer& log) noexcept
+  : m_log(log) // () for DR 1288
+  , m_point{log.open_savepoint()}
+  , m_active{true}
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+inline sg::undo_scope::~undo_scope() noexcept
+{
+  if(m_active)
+    m_log.rollback_to(m_point);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::undo_scope::commit() noexcept
+{
+  m_active = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void sg::undo_scope::dismiss() noexcept
+{
+  commit();
+}
+
+#endif /* UNDO_BUFFER_HPP_ */